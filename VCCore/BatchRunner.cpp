@@ -0,0 +1,329 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+/// @file
+
+#include "vcconfig.h"
+#include "BatchRunner.h"
+#include "C64.h"
+#include "Emulator.h"
+#include "Script.h"
+#include <iomanip>
+#include <thread>
+
+namespace vc64 {
+
+void
+BatchRunner::Worker::callback(const void *listener, Message msg)
+{
+    ((Worker *)listener)->process(msg);
+}
+
+void
+BatchRunner::Worker::process(Message msg)
+{
+    switch (msg.type) {
+
+        case Msg::ABORT:
+
+            exitCode = msg.value;
+            finished = true;
+            wakeUp();
+            break;
+
+        case Msg::RSH_ERROR:
+
+            scriptError = true;
+            finished = true;
+            wakeUp();
+            break;
+
+        default:
+            break;
+    }
+}
+
+BatchRunner::BatchRunner(const std::vector<fs::path> &jobs, const Config &config) :
+config(config), jobs(jobs)
+{
+    // Don't create more instances than needed
+    this->config.instances = std::clamp(config.instances, isize(1), std::max(isize(1), isize(jobs.size())));
+
+    // A golden snapshot implies a warm start
+    if (!config.snapshot.empty()) this->config.warmStart = true;
+}
+
+isize
+BatchRunner::run()
+{
+    utl::Clock clock;
+
+    results.clear();
+    results.resize(jobs.size());
+    next = 0;
+
+    // Prepare the golden state
+    if (config.warmStart) createGoldenState();
+
+    /* Create all emulator instances upfront. This is done sequentially,
+     * because the constructors of some components touch static data.
+     */
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (isize i = 0; i < config.instances; i++) {
+
+        workers.push_back(std::make_unique<Worker>());
+        setup(*workers.back());
+    }
+
+    // Process all jobs in parallel
+    std::vector<std::thread> threads;
+    for (auto &worker : workers) {
+        threads.emplace_back([this, &worker]() { work(*worker); });
+    }
+    for (auto &thread : threads) thread.join();
+
+    elapsed = clock.getElapsedTime().asSeconds();
+    golden = nullptr;
+
+    // Count the jobs that did not pass
+    return std::count_if(results.begin(), results.end(), [](const Result &r) {
+        return r.status != Status::PASSED; });
+}
+
+void
+BatchRunner::configure(VirtualC64 &emu)
+{
+    // Plug in the three MEGA65 OpenROMs
+    emu.c64.installOpenRoms();
+    emu.c64.deleteRom(RomType::VC1541);
+    emu.set(Opt::DRV_CONNECT, false, 0);
+    emu.set(Opt::DRV_CONNECT, false, 1);
+
+    // Let test programs report their result via the debug cartridge
+    emu.set(Opt::DBG_DEBUGCART, true);
+
+    // Store screenshots taken by scripts in the output directory
+    {   emu.suspend();
+        emu.c64.c64->regressionTester.screenshotPath = config.outputDir;
+        emu.resume();
+    }
+}
+
+void
+BatchRunner::createGoldenState()
+{
+    golden = std::make_unique<VirtualC64>();
+    configure(*golden);
+
+    // Launch the emulator thread (the instance is never powered on)
+    golden->launch();
+
+    if (!config.snapshot.empty()) {
+
+        // Restore the golden state from a snapshot
+        golden->c64.loadSnapshot(config.snapshot);
+
+    } else {
+
+        // Boot the C64
+        {   golden->suspend();
+
+            auto &c64 = *golden->c64.c64;
+            c64.hardReset();
+            c64.fastForward(isize(bootTime * c64.refreshRate()));
+
+            golden->resume();
+        }
+    }
+}
+
+void
+BatchRunner::setup(Worker &worker)
+{
+    auto &emu = worker.emu;
+
+    configure(emu);
+
+    // Launch the emulator thread
+    emu.launch(&worker, Worker::callback);
+
+    // Run as fast as possible
+    emu.warpOn(1);
+    emu.run();
+}
+
+void
+BatchRunner::work(Worker &worker)
+{
+    for (isize i = next++; i < isize(jobs.size()); i = next++) {
+
+        results[i] = execute(worker, jobs[i]);
+
+        if (config.verbose) {
+
+            std::lock_guard<std::mutex> lock(outputMutex);
+            std::cout << "[" << (i + 1) << "/" << jobs.size() << "] ";
+            std::cout << jobs[i].string() << ": " << statusKey(results[i].status);
+            if (!results[i].error.empty()) std::cout << " (" << results[i].error << ")";
+            std::cout << std::endl;
+        }
+    }
+}
+
+BatchRunner::Result
+BatchRunner::execute(Worker &worker, const fs::path &path)
+{
+    auto &emu = worker.emu;
+    auto &c64 = *emu.c64.c64;
+    auto result = Result { .path = path };
+
+    utl::Clock clock;
+
+    try {
+
+        // Cancel the remainder of the previous job
+        {   emu.suspend();
+            c64.retroShell.abortScript();
+            c64.retroShell.enterCommander();
+            worker.finished = false;
+            worker.exitCode = -1;
+            worker.scriptError = false;
+
+            // Revert to the golden state
+            if (golden) { c64 = *golden->c64.c64; emu.emu->markAsDirty(); }
+
+            emu.resume();
+        }
+
+        // Start from a clean state and arm the watchdog
+        if (!golden) emu.hardReset();
+        emu.set(Opt::DBG_WATCHDOG, C64::sec(config.timeout));
+
+        if (Script::isCompatible(path)) {
+
+            // Execute the script
+            emu.retroShell.execScript(path);
+
+        } else if (golden) {
+
+            // Launch the program
+            emu.retroShell.execScript("regression run \"" + path.string() + "\"");
+
+        } else {
+
+            // Give the C64 some time to boot and launch the program
+            emu.retroShell.execScript("wait " + std::to_string(isize(bootTime)) +
+                                      "\nregression run \"" + path.string() + "\"");
+        }
+
+    } catch (std::exception &e) {
+
+        result.status = Status::ABORTED;
+        result.error = e.what();
+        return result;
+    }
+
+    /* Wait for the job to terminate. The watchdog measures emulated time. As a
+     * safety net, we also give up if the emulator stalls and the watchdog does
+     * not fire in time.
+     */
+    auto deadline = utl::Time::now() + utl::Time::seconds(config.timeout + 10.0);
+    while (!worker.finished) {
+
+        auto now = utl::Time::now();
+        if (now >= deadline) break;
+        worker.waitForWakeUp(deadline - now);
+    }
+
+    {   emu.suspend();
+
+        // Evaluate the outcome
+        if (worker.scriptError) {
+
+            result.status = Status::FAILED;
+            result.error = "Script error";
+
+        } else if (!worker.finished || c64.regressionTester.watchdogExpired) {
+
+            result.status = Status::TIMEOUT;
+
+        } else {
+
+            result.status = worker.exitCode == 0 ? Status::PASSED : Status::FAILED;
+        }
+        result.exitCode = worker.exitCode;
+
+        // Dump the texture
+        try {
+
+            auto texture = config.outputDir / path.stem();
+            texture.replace_extension("raw");
+            c64.regressionTester.dumpTexture(c64, texture);
+            result.texture = texture;
+
+        } catch (std::exception &e) {
+
+            result.error = e.what();
+        }
+
+        emu.resume();
+    }
+
+    // Disarm the watchdog
+    emu.set(Opt::DBG_WATCHDOG, 0);
+
+    result.elapsed = clock.getElapsedTime().asSeconds();
+    return result;
+}
+
+const char *
+BatchRunner::statusKey(Status status)
+{
+    switch (status) {
+
+        case Status::PASSED:    return "PASSED";
+        case Status::FAILED:    return "FAILED";
+        case Status::TIMEOUT:   return "TIMEOUT";
+        case Status::ABORTED:   return "ABORTED";
+    }
+    return "???";
+}
+
+void
+BatchRunner::summary(std::ostream &os) const
+{
+    isize count[4] = { };
+
+    os << std::endl;
+    for (auto &r : results) {
+
+        count[isize(r.status)]++;
+        if (r.status == Status::PASSED) continue;
+
+        os << std::left << std::setw(9) << statusKey(r.status) << r.path.string();
+        if (r.status == Status::FAILED && r.exitCode >= 0) os << " (exit code " << r.exitCode << ")";
+        if (!r.error.empty()) os << " (" << r.error << ")";
+        os << std::endl;
+    }
+
+    os << std::endl;
+    os << "   Jobs: " << results.size() << std::endl;
+    os << " Passed: " << count[isize(Status::PASSED)] << std::endl;
+    os << " Failed: " << count[isize(Status::FAILED)] << std::endl;
+    os << "Timeout: " << count[isize(Status::TIMEOUT)] << std::endl;
+    os << "Aborted: " << count[isize(Status::ABORTED)] << std::endl;
+    os << std::endl;
+    os << std::fixed << std::setprecision(2);
+    os << "Executed on " << config.instances << " instances in " << elapsed << " sec";
+    os << " (" << jobsPerSecond() << " jobs/sec, " << (config.warmStart ? "warm" : "cold") << " start)" << std::endl;
+}
+
+}
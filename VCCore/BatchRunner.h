@@ -0,0 +1,182 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "VirtualC64.h"
+#include "utl/abilities/Wakeable.h"
+#include <atomic>
+#include <memory>
+
+namespace vc64 {
+
+/* The batch runner executes a list of RetroShell scripts or media files on a
+ * pool of emulator instances, one per hardware thread by default. Each
+ * instance is created and configured only once and then reused for all jobs
+ * that are assigned to it. Between two jobs, the instance is hard-reset.
+ *
+ * In warm-start mode, a pre-booted golden state is created once, either by
+ * loading a snapshot or by letting a separate instance boot. Before a job is
+ * started, this state is cloned into the worker instance, utilizing the same
+ * mechanism that creates the run-ahead instance. This saves the time it
+ * takes the C64 to boot.
+ *
+ * Files with extension .retrosh are executed as RetroShell scripts. All other
+ * files are flashed into memory and started with RUN. A job passes if it
+ * terminates via a 'shutdown' command or by writing zero into the debug
+ * cartridge register. It fails if it writes a non-zero value or if a script
+ * error occurs. It times out if the watchdog timer expires. When a job has
+ * finished, the visible portion of the texture is written to the output
+ * directory as <name>.raw.
+ */
+class BatchRunner {
+
+public:
+
+    enum class Status { PASSED, FAILED, TIMEOUT, ABORTED };
+
+    struct Config {
+
+        // Number of emulator instances
+        isize instances = 1;
+
+        // Maximum emulated time per job in seconds
+        double timeout = 60.0;
+
+        // Directory for storing textures
+        fs::path outputDir = "/tmp";
+
+        // Indicates if jobs start from a pre-booted golden state
+        bool warmStart = false;
+
+        // Snapshot providing the golden state (booted in memory if empty)
+        fs::path snapshot;
+
+        // Indicates if progress information should be printed
+        bool verbose = false;
+    };
+
+    struct Result {
+
+        // The executed script or media file
+        fs::path path;
+
+        // Outcome of the test
+        Status status = Status::ABORTED;
+
+        // Value passed to Msg::ABORT or -1 if the job has not terminated
+        i64 exitCode = -1;
+
+        // Location of the dumped texture (empty if none has been written)
+        fs::path texture;
+
+        // Consumed wall-clock time in seconds
+        double elapsed = 0.0;
+
+        // Error description
+        string error;
+    };
+
+private:
+
+    // A single emulator instance of the pool
+    struct Worker : utl::Wakeable {
+
+        VirtualC64 emu;
+
+        // Indicates if the current job has terminated
+        std::atomic<bool> finished = false;
+
+        // Return value of the current job
+        std::atomic<i64> exitCode = -1;
+
+        // Indicates if a script error has occurred
+        std::atomic<bool> scriptError = false;
+
+        static void callback(const void *listener, Message msg);
+        void process(Message msg);
+    };
+
+    // Emulated time needed to boot the C64
+    static constexpr double bootTime = 3.0;
+
+    // Current configuration
+    Config config;
+
+    // Jobs to execute
+    std::vector<fs::path> jobs;
+
+    // Collected results (same order as jobs)
+    std::vector<Result> results;
+
+    // Index of the next job to pick up
+    std::atomic<isize> next = 0;
+
+    // Instance holding the golden state in warm-start mode
+    std::unique_ptr<VirtualC64> golden;
+
+    // Consumed wall-clock time in seconds
+    double elapsed = 0.0;
+
+    // Serializes console output
+    std::mutex outputMutex;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    BatchRunner(const std::vector<fs::path> &jobs, const Config &config);
+
+
+    //
+    // Running
+    //
+
+public:
+
+    // Runs all jobs and returns the number of jobs that did not pass
+    isize run();
+
+    // Prints the pass/fail summary
+    void summary(std::ostream &os) const;
+
+    // Returns the collected results
+    const std::vector<Result> &getResults() const { return results; }
+
+    // Returns the number of executed jobs per second
+    double jobsPerSecond() const { return elapsed > 0 ? double(results.size()) / elapsed : 0.0; }
+
+    // Returns a textual representation for a status value
+    static const char *statusKey(Status status);
+
+private:
+
+    // Applies the common configuration to an emulator instance
+    void configure(VirtualC64 &emu);
+
+    // Creates the golden state for warm-starting jobs
+    void createGoldenState();
+
+    // Configures and launches an emulator instance of the pool
+    void setup(Worker &worker);
+
+    // Picks up and executes jobs until no job is left
+    void work(Worker &worker);
+
+    // Executes a single job
+    Result execute(Worker &worker, const fs::path &path);
+};
+
+}
@@ -323,6 +323,19 @@ C64::prefix(LogLevel level, const std::source_location &loc) const
     }
 }
 
+void
+C64::syncWith(C64 &other)
+{
+    // Copy the large memory areas incrementally
+    mem.syncWith(other.mem);
+    expansionport.syncWith(other.expansionport);
+    drive8.syncWith(other.drive8);
+    drive9.syncWith(other.drive9);
+
+    // Clone everything else
+    cloneState(other);
+}
+
 void 
 C64::_didReset(bool hard)
 {
@@ -393,6 +406,9 @@ C64::operator << (SerResetter &worker)
     // Restore persistent events
     if (insEventId) scheduleRel<SLOT_INS>(0, insEventId);
 
+    // Rearm the watchdog timer
+    if (auto cycles = regressionTester.getConfig().watchdog) regressionTester.setWatchdog(cycles);
+
     flags = 0;
     rasterCycle = 1;
 }
@@ -435,11 +451,7 @@ C64::updateClockFrequency()
 {
     durationOfOneCycle = 10000000000 / nativeClockFrequency();
 
-    auto frequency = clockFrequency();
-    sidBridge.sid[0].setClockFrequency((u32)frequency);
-    sidBridge.sid[1].setClockFrequency((u32)frequency);
-    sidBridge.sid[2].setClockFrequency((u32)frequency);
-    sidBridge.sid[3].setClockFrequency((u32)frequency);
+    sidBridge.setClockFrequency((u32)clockFrequency());
 }
 
 /*
@@ -676,6 +688,9 @@ C64::update(CmdQueue &queue)
 
         loginfo(CMD_DEBUG, "Command: %s\n", CmdEnum::key(cmd.type));
 
+        // Commands other than input events require a full run-ahead update
+        if (!cmd.isInputEvent()) emulator.markAsDirty();
+
         switch (cmd.type) {
 
             case Cmd::CONFIG:
@@ -712,6 +727,11 @@ C64::update(CmdQueue &queue)
                 processCommand(cmd);
                 break;
 
+            case Cmd::REWIND:
+
+                rewindBuffer.processCommand(cmd);
+                break;
+
             case Cmd::CPU_BRK:
             case Cmd::CPU_NMI:
             case Cmd::BP_SET_AT:
@@ -814,71 +834,179 @@ C64::update(CmdQueue &queue)
 
     // Inform the GUI about new RetroShell content
     if (retroShell.isDirty) { retroShell.isDirty = false; msgQueue.put(Msg::RSH_UPDATE); }
+
+    // Hand over all coalescable messages collected since the last update
+    msgQueue.flush();
 }
 
 void
-C64::computeFrame()
+C64::computeSlice(isize slices)
 {
-    if (emulator.get(Opt::VICII_POWER_SAVE)) {
-        computeFrame(emulator.isWarping() && (frame & 7) != 0);
+    // Determine the scanline where the slice ends
+    u16 stop = 0;
+    for (isize i = 1, lines = vic.getLinesPerFrame(); i < slices; i++) {
+
+        if (auto line = u16(i * lines / slices); line > scanline) { stop = line; break; }
+    }
+
+    if (config.maxSpeed) {
+        computeFrame(true, stop);
+    } else if (emulator.get(Opt::VICII_POWER_SAVE)) {
+        computeFrame(emulator.isWarping() && (frame & 7) != 0, stop);
     } else {
-        computeFrame(false);
+        computeFrame(false, stop);
     }
 }
 
 void 
-C64::computeFrame(bool headless)
+C64::computeFrame(bool headless, u16 stop)
 {
     setHeadless(headless);
+    stopLine = stop;
 
     cpu.debugger.watchpointPC = -1;
     cpu.debugger.breakpointPC = -1;
 
+    // Select the VICII kernel if a new frame begins
+    if (scanline == 0 && rasterCycle == 1) vic.updateKernel();
+
+    bool enable8 = drive8.isPoweredOn() && drive8.mem.hasRom();
+    bool enable9 = drive9.isPoweredOn() && drive9.mem.hasRom();
+
+    // Hand the drives over to the drive thread if possible
+    if ((enable8 || enable9) && driveThread.canTakeOver()) {
+
+        driveThread.begin(enable8, enable9, durationOfOneCycle);
+        enable8 = enable9 = false;
+    }
+
+    try {
+
+        // Dispatch
+        switch ((enable8                                ? 4 : 0) |
+                (enable9                                ? 2 : 0) |
+                (expansionport.needsAccurateEmulation() ? 1 : 0) ) {
+
+            case 0b000: execute <false, false, false> (); break;
+            case 0b001: execute <false, false, true>  (); break;
+            case 0b010: execute <false, true,  false> (); break;
+            case 0b011: execute <false, true,  true>  (); break;
+            case 0b100: execute <true,  false, false> (); break;
+            case 0b101: execute <true,  false, true>  (); break;
+            case 0b110: execute <true,  true,  false> (); break;
+            case 0b111: execute <true,  true,  true>  (); break;
+
+            default:
+                fatalError;
+        }
+
+    } catch (...) {
+
+        // Take the drives back if the frame has been interrupted
+        driveThread.end();
+        throw;
+    }
+
+    // Take the drives back if the slice has ended inside the frame
+    driveThread.end();
+}
+
+template <bool enable8, bool enable9, bool execExp> void
+C64::execute()
+{
     // Dispatch
-    switch ((drive8.isPoweredOn() && drive8.mem.hasRom() ? 4 : 0) |
-            (drive9.isPoweredOn() && drive9.mem.hasRom() ? 2 : 0) |
-            (expansionport.needsAccurateEmulation()      ? 1 : 0) ) {
-
-        case 0b000: execute <false, false, false> (); break;
-        case 0b001: execute <false, false, true>  (); break;
-        case 0b010: execute <false, true,  false> (); break;
-        case 0b011: execute <false, true,  true>  (); break;
-        case 0b100: execute <true,  false, false> (); break;
-        case 0b101: execute <true,  false, true>  (); break;
-        case 0b110: execute <true,  true,  false> (); break;
-        case 0b111: execute <true,  true,  true>  (); break;
+    switch (vic.getKernel()) {
+
+        case 0:                             execute <enable8, enable9, execExp, 0> (); break;
+        case DEBUG_CYCLE:                   execute <enable8, enable9, execExp, DEBUG_CYCLE> (); break;
+        case HEADLESS_CYCLE:                execute <enable8, enable9, execExp, HEADLESS_CYCLE> (); break;
+        case PAL_CYCLE:                     execute <enable8, enable9, execExp, PAL_CYCLE> (); break;
+        case PAL_CYCLE | DEBUG_CYCLE:       execute <enable8, enable9, execExp, PAL_CYCLE | DEBUG_CYCLE> (); break;
+        case PAL_CYCLE | HEADLESS_CYCLE:    execute <enable8, enable9, execExp, PAL_CYCLE | HEADLESS_CYCLE> (); break;
+        case R56A_CYCLE:                    execute <enable8, enable9, execExp, R56A_CYCLE> (); break;
+        case R56A_CYCLE | DEBUG_CYCLE:      execute <enable8, enable9, execExp, R56A_CYCLE | DEBUG_CYCLE> (); break;
+        case R56A_CYCLE | HEADLESS_CYCLE:   execute <enable8, enable9, execExp, R56A_CYCLE | HEADLESS_CYCLE> (); break;
 
         default:
             fatalError;
     }
 }
 
-template <bool enable8, bool enable9, bool execExp> void
+template <bool enable8, bool enable9, bool execExp, u16 kernel> void
 C64::execute()
 {
     auto lastCycle = vic.getCyclesPerLine();
+    auto blocks = config.blockExec;
 
     try {
 
         do {
 
+            /* Take the fast path as long as all drives are in power-save mode.
+             * In this case, we don't have to check the drives in each cycle.
+             * Drives that wake up raise RL::DRIVE_WAKEUP which forces us to
+             * emulate them in the same cycle and to leave the fast path.
+             */
+            if constexpr ((enable8 || enable9) && !execExp) {
+
+                if (drivesAsleep<enable8, enable9>()) {
+
+                    while (rasterCycle <= lastCycle) {
+
+                        // Run all cycles up to the next event without emulating the drives
+                        if (!blocks || !executeBlock<false, false, false, kernel>(lastCycle)) {
+
+                            if (rasterCycle > lastCycle) break;
+
+                            // Execute one cycle without emulating the drives
+                            executeCycle<false, false, false, kernel>();
+                        }
+
+                        if (flags) {
+
+                            // Emulate all drives that have woken up in this cycle
+                            if constexpr (enable8) { if (drive8.needsEmulation) drive8.execute(durationOfOneCycle); }
+                            if constexpr (enable9) { if (drive9.needsEmulation) drive9.execute(durationOfOneCycle); }
+
+                            // Process all pending flags
+                            processFlags();
+
+                            // Switch to the slow path if a drive is awake
+                            if (!drivesAsleep<enable8, enable9>()) { rasterCycle++; break; }
+                        }
+
+                        rasterCycle++;
+                    }
+                }
+            }
+
             // Run the emulator for the (rest of the) current scanline
-            for (; rasterCycle <= lastCycle; rasterCycle++) {
+            while (rasterCycle <= lastCycle) {
+
+                // Run all cycles up to the next event
+                if (!blocks || !executeBlock<enable8, enable9, execExp, kernel>(lastCycle)) {
 
-                // Execute one cycle
-                executeCycle<enable8, enable9, execExp>();
+                    if (rasterCycle > lastCycle) break;
+
+                    // Execute one cycle
+                    executeCycle<enable8, enable9, execExp, kernel>();
+                }
 
                 // Process all pending flags
                 if (flags) processFlags();
+
+                rasterCycle++;
             }
 
             // Finish the scanline
             endScanline();
 
-        } while (scanline != 0);
+        } while (scanline != stopLine);
 
     } catch (StateChangeException &) {
 
+        blockEnd = 0;
+
         // Finish the scanline if needed
         if (++rasterCycle > lastCycle) endScanline();
 
@@ -887,7 +1015,35 @@ C64::execute()
     }
 }
 
-template <bool enable8, bool enable9, bool execExp>
+template <bool enable8, bool enable9, bool execExp, u16 kernel> bool
+C64::executeBlock(isize lastCycle)
+{
+    // Persistent flags (e.g., single stepping) require a check in each cycle
+    if (flags) return false;
+
+    auto first = rasterCycle;
+
+    // The block ends at the next event or at the end of the scanline
+    blockEnd = std::min(nextTrigger, Cycle(cpu.clock + 2 + (lastCycle - rasterCycle)));
+
+    for (; cpu.clock + 1 < blockEnd; rasterCycle++) {
+
+        // Execute one cycle without checking for events and flags
+        executeCycle<enable8, enable9, execExp, kernel, false>();
+    }
+
+    blockEnd = 0;
+
+    /* If a flag has cut the block short, the flag has been raised in the
+     * last executed cycle. In this case, we step back to this cycle and let
+     * the caller process the flags as usual.
+     */
+    if (flags && rasterCycle > first) { rasterCycle--; return true; }
+
+    return false;
+}
+
+template <bool enable8, bool enable9, bool execExp, u16 kernel, bool checkEvents>
 alwaysinline void C64::executeCycle()
 {
     //
@@ -916,8 +1072,8 @@ alwaysinline void C64::executeCycle()
     // First clock phase (o2 low)
     //
 
-    if (nextTrigger <= cycle) processEvents(cycle);
-    (vic.*vic.vicfunc[rasterCycle])();
+    if constexpr (checkEvents) { if (nextTrigger <= cycle) processEvents(cycle); }
+    vic.executeCycle<kernel>(rasterCycle);
 
 
     //
@@ -930,11 +1086,24 @@ alwaysinline void C64::executeCycle()
     if constexpr (execExp) { expansionport.execute(); }
 }
 
+template <bool enable8, bool enable9> bool
+C64::drivesAsleep() const
+{
+    if constexpr (enable8) { if (drive8.needsEmulation) return false; }
+    if constexpr (enable9) { if (drive9.needsEmulation) return false; }
+    return true;
+}
+
 void
 C64::processFlags()
 {
     bool interrupt = false;
 
+    if (flags & RL::DRIVE_WAKEUP) {
+
+        clearFlag(RL::DRIVE_WAKEUP);
+    }
+
     if (flags & RL::BREAKPOINT) {
 
         clearFlag(RL::BREAKPOINT);
@@ -1011,6 +1180,26 @@ C64::fastForward(isize frames)
     while (frame < target) computeFrame();
 }
 
+void
+C64::fastForwardCycles(Cycle cycles)
+{
+    // Let the alarm slot raise RL::STOP when the target cycle is reached
+    stopCycle = cpu.clock + cycles;
+    scheduleNextAlarm();
+
+    try {
+
+        while (cpu.clock < stopCycle) computeFrame();
+
+    } catch (const StateChangeException &) {
+
+        // The frame has been interrupted
+    }
+
+    stopCycle = INT64_MAX;
+    scheduleNextAlarm();
+}
+
 void
 C64::_isReady() const
 {
@@ -1170,6 +1359,9 @@ C64::setAutoInspectionMask(u64 mask)
 void
 C64::endScanline()
 {
+    // Let the drive thread follow
+    driveThread.advance(cpu.clock);
+
     cia1.tod.increment();
     cia2.tod.increment();
 
@@ -1187,6 +1379,9 @@ C64::endScanline()
 void
 C64::endFrame()
 {
+    // Take the drives back from the drive thread
+    driveThread.end();
+
     frame++;
     
     vic.endFrame();
@@ -1198,6 +1393,8 @@ C64::endFrame()
     port2.execute();
     drive8.vsyncHandler();
     drive9.vsyncHandler();
+    rewindBuffer.endFrame();
+    tracer.flush();
 }
 
 void
@@ -1297,6 +1494,7 @@ C64::processEvents(Cycle cycle)
         //
 
         if (isDue<SLOT_SER>(cycle)) {
+            driveThread.sync();
             iec.update();
         }
 
@@ -1306,6 +1504,9 @@ C64::processEvents(Cycle cycle)
 
         if (isDue<SLOT_TER>(cycle)) {
 
+            // Some of the following events inspect or modify the drives
+            driveThread.sync();
+
             //
             // Check tertiary slots
             //
@@ -1399,6 +1600,9 @@ C64::setFlag(u32 flag)
     SYNCHRONIZED
 
     flags |= flag;
+
+    // Cut the current cycle block short
+    blockEnd = 0;
 }
 
 void
@@ -1657,9 +1861,14 @@ C64::processSNPEvent(EventID eventId)
     // Ignore the run-ahead instance
     if (objid != 0) { cancel<SLOT_SNP>(); return; }
 
-    // Take snapshot and hand it over to the GUI
-    auto *snapshot = takeSnapshot(Compressor(data[SLOT_SNP] >> 24));
-    msgQueue.put( Message { .type = Msg::SNAPSHOT_TAKEN, .snapshot = { snapshot } } );
+    auto start = utl::Time::now();
+
+    /* Take the snapshot. Only the serialization is done on the emulator
+     * thread. The snapshot is compressed in the background and handed over to
+     * the GUI when compression has finished.
+     */
+    auto *snapshot = takeSnapshot(Compressor::NONE);
+    emulator.compressSnapshot(snapshot, Compressor(data[SLOT_SNP] >> 24), start);
 
     // Schedule the next event
     scheduleNextSNPEvent();
@@ -2189,6 +2398,11 @@ C64::processAlarmEvent()
             it++;
         }
     }
+    if (stopCycle <= cpu.clock) {
+
+        stopCycle = INT64_MAX;
+        signalStop();
+    }
     scheduleNextAlarm();
 }
 
@@ -2199,6 +2413,11 @@ C64::scheduleNextAlarm()
 
     cancel<SLOT_ALA>();
 
+    if (stopCycle < trigger) {
+        scheduleAbs<SLOT_ALA>(stopCycle, ALA_TRIGGER);
+        trigger = stopCycle;
+    }
+
     for(Alarm alarm : alarms) {
 
         if (alarm.trigger < trigger) {
@@ -42,6 +42,8 @@
 #include "Datasette.h"
 #include "Mouse.h"
 #include "Monitor.h"
+#include "VirtualDrive.h"
+#include "DriveThread.h"
 
 // Cartridges
 #include "Cartridge.h"
@@ -62,6 +64,8 @@
 // Misc
 #include "Host.h"
 #include "RegressionTester.h"
+#include "RewindBuffer.h"
+#include "Tracer.h"
 #include "RemoteManager.h"
 #include "RetroShell.h"
 #include "RshServer.h"
@@ -115,8 +119,13 @@ class C64 final : public CoreComponent, public Inspectable<C64Info> {
         Opt::C64_WARP_BOOT,
         Opt::C64_WARP_MODE,
         Opt::C64_SPEED_BOOST,
+        Opt::C64_MAX_SPEED,
         Opt::C64_VSYNC,
-        Opt::C64_RUN_AHEAD
+        Opt::C64_RUN_AHEAD,
+        Opt::C64_DRIVE_THREAD,
+        Opt::C64_SID_THREAD,
+        Opt::C64_SLICES,
+        Opt::C64_BLOCK_EXEC
     };
     
 private:
@@ -162,14 +171,20 @@ public:
     ParCable parCable = ParCable(*this);
     Datasette datasette = Datasette(*this);
     Monitor monitor = Monitor(*this);
+    VirtualDrive vdrive = VirtualDrive(*this);
     
     // Gateway to the GUI
     MsgQueue msgQueue = MsgQueue();
 
+    // Worker thread for emulating the drives in parallel
+    DriveThread driveThread = DriveThread(*this);
+
     // Misc
     RetroShell retroShell = RetroShell(*this);
     RemoteManager remoteManager = RemoteManager(*this);
     RegressionTester regressionTester = RegressionTester(*this);
+    RewindBuffer rewindBuffer = RewindBuffer(*this);
+    Tracer tracer = Tracer(*this);
 
 
     //
@@ -190,6 +205,13 @@ public:
     // Next trigger cycle
     Cycle nextTrigger = NEVER;
 
+    /* End of the cycle block that is currently executed (exclusive). Inside
+     * a block, no event is due and no run loop flag is set, so the run loop
+     * skips both checks. Scheduling an earlier event or setting a flag cuts
+     * the block short. The value is 0 outside of blocks.
+     */
+    Cycle blockEnd = 0;
+
 
     //
     // Emulator thread
@@ -215,6 +237,12 @@ private:
     typedef struct { Cycle trigger; i64 payload; } Alarm;
     std::vector<Alarm> alarms;
 
+    // Cycle at which fastForwardCycles() interrupts execution
+    Cycle stopCycle = INT64_MAX;
+
+    // Scanline at which computeSlice() interrupts execution (0 = end of frame)
+    u16 stopLine = 0;
+
 
     //
     // State
@@ -308,6 +336,22 @@ public:
     C64& operator= (const C64& other) {
 
         CLONE(mem)
+        CLONE(expansionport)
+        CLONE(drive8)
+        CLONE(drive9)
+        cloneState(other);
+
+        return *this;
+    }
+
+    // Copies only those parts of another instance that have been modified
+    void syncWith(C64 &other);
+
+private:
+
+    // Clones everything except memory, cartridge, and drives
+    void cloneState(const C64& other) {
+
         CLONE(cpu)
         CLONE(cia1)
         CLONE(cia2)
@@ -318,17 +362,17 @@ public:
         CLONE(supply)
         CLONE(port1)
         CLONE(port2)
-        CLONE(expansionport)
         CLONE(iec)
         CLONE(userPort)
         CLONE(keyboard)
-        CLONE(drive8)
-        CLONE(drive9)
         CLONE(parCable)
         CLONE(datasette)
         CLONE(monitor)
+        CLONE(vdrive)
         CLONE(retroShell)
         CLONE(regressionTester)
+        CLONE(rewindBuffer)
+        CLONE(tracer)
 
         CLONE_ARRAY(trigger)
         CLONE_ARRAY(eventid)
@@ -342,10 +386,10 @@ public:
         CLONE(durationOfOneCycle)
 
         CLONE(config)
-
-        return *this;
     }
 
+public:
+
 
     //
     // Methods from Serializable
@@ -515,22 +559,31 @@ public:
     // Updates the clock frequency and all variables derived from it
     void updateClockFrequency();
 
+    // Emulates a certain number of frames (used by the run-ahead instance)
+    void fastForward(isize frames);
+
+    // Emulates a certain number of cycles (may end in the middle of a frame)
+    void fastForwardCycles(Cycle cycles);
+
 private:
 
     // Called by the Emulator class in it's own update function
     void update(CmdQueue &queue);
 
     // Emulates a frame
-    void computeFrame();
-    void computeFrame(bool headless);
+    void computeFrame() { computeSlice(1); }
+    void computeFrame(bool headless, u16 stop = 0);
     void computeFrameHeadless() { computeFrame(true); }
+
+    // Emulates the next fraction of a frame (the frame is split in 'slices' parts)
+    void computeSlice(isize slices);
     template <bool, bool, bool> void execute();
-    template <bool, bool, bool> alwaysinline void executeCycle();
+    template <bool, bool, bool, u16> void execute();
+    template <bool, bool, bool, u16> bool executeBlock(isize lastCycle);
+    template <bool, bool, bool, u16, bool = true> alwaysinline void executeCycle();
+    template <bool, bool> bool drivesAsleep() const;
     void processFlags();
 
-    // Fast-forward the run-ahead instance
-    void fastForward(isize frames);
-
 
     //
     // Controlling the run loop
@@ -589,7 +642,7 @@ public:
         this->trigger[s] = cycle;
         this->eventid[s] = id;
 
-        if (cycle < nextTrigger) nextTrigger = cycle;
+        if (cycle < nextTrigger) { nextTrigger = cycle; if (cycle < blockEnd) blockEnd = cycle; }
 
         if constexpr (isTertiarySlot(s)) {
             if (cycle < trigger[SLOT_TER]) trigger[SLOT_TER] = cycle;
@@ -608,7 +661,7 @@ public:
     template<EventSlot s> void rescheduleAbs(Cycle cycle)
     {
         trigger[s] = cycle;
-        if (cycle < nextTrigger) nextTrigger = cycle;
+        if (cycle < nextTrigger) { nextTrigger = cycle; if (cycle < blockEnd) blockEnd = cycle; }
 
         if constexpr (isTertiarySlot(s)) {
             if (cycle < trigger[SLOT_TER]) trigger[SLOT_TER] = cycle;
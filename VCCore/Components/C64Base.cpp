@@ -43,9 +43,12 @@ C64::C64(class Emulator& ref, isize id) : CoreComponent(ref, id)
         &parCable,
         &datasette,
         &monitor,
+        &vdrive,
         &remoteManager,
         &retroShell,
-        &regressionTester
+        &regressionTester,
+        &rewindBuffer,
+        &tracer
     };
 
     // Assign a unique ID to the CPU
@@ -87,6 +90,7 @@ C64::_dump(Category category, std::ostream &os) const
         if (flags & RL::SINGLE_CYCLE)   str = append(str, "SINGLE_CYCLE");
         if (flags & RL::FINISH_LINE)    str = append(str, "FINISH_LINE");
         if (flags & RL::FINISH_FRAME)   str = append(str, "FINISH_FRAME");
+        if (flags & RL::DRIVE_WAKEUP)   str = append(str, "DRIVE_WAKEUP");
 
         os << tab("Runloop flags");
         os << (str.empty() ? "-" : str) << std::endl;
@@ -191,7 +195,12 @@ C64::getOption(Opt opt) const
         case Opt::C64_WARP_MODE:         return (i64)config.warpMode;
         case Opt::C64_SPEED_BOOST:       return (i64)config.speedBoost;
         case Opt::C64_VSYNC:             return (i64)config.vsync;
+        case Opt::C64_MAX_SPEED:         return (i64)config.maxSpeed;
         case Opt::C64_RUN_AHEAD:         return (i64)config.runAhead;
+        case Opt::C64_DRIVE_THREAD:      return (i64)config.driveThread;
+        case Opt::C64_SID_THREAD:        return (i64)config.sidThread;
+        case Opt::C64_SLICES:            return (i64)config.slices;
+        case Opt::C64_BLOCK_EXEC:        return (i64)config.blockExec;
 
         default:
             fatalError;
@@ -222,6 +231,10 @@ C64::checkOption(Opt opt, i64 value)
             return;
 
         case Opt::C64_VSYNC:
+        case Opt::C64_MAX_SPEED:
+        case Opt::C64_DRIVE_THREAD:
+        case Opt::C64_SID_THREAD:
+        case Opt::C64_BLOCK_EXEC:
 
             return;
 
@@ -232,6 +245,13 @@ C64::checkOption(Opt opt, i64 value)
             }
             return;
 
+        case Opt::C64_SLICES:
+
+            if (value < 1 || value > 16) {
+                throw CoreError(CoreError::OPT_INV_ARG, "1...16");
+            }
+            return;
+
         default:
             throw CoreError(CoreError::OPT_UNSUPPORTED);
     }
@@ -259,6 +279,11 @@ C64::setOption(Opt opt, i64 value)
             config.vsync = bool(value);
             return;
 
+        case Opt::C64_MAX_SPEED:
+
+            config.maxSpeed = bool(value);
+            return;
+
         case Opt::C64_SPEED_BOOST:
 
             config.speedBoost = isize(value);
@@ -270,6 +295,26 @@ C64::setOption(Opt opt, i64 value)
             config.runAhead = isize(value);
             return;
 
+        case Opt::C64_DRIVE_THREAD:
+
+            config.driveThread = bool(value);
+            return;
+
+        case Opt::C64_SID_THREAD:
+
+            config.sidThread = bool(value);
+            return;
+
+        case Opt::C64_SLICES:
+
+            config.slices = isize(value);
+            return;
+
+        case Opt::C64_BLOCK_EXEC:
+
+            config.blockExec = bool(value);
+            return;
+
         default:
             fatalError;
     }
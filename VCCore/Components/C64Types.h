@@ -307,9 +307,24 @@ typedef struct
     
     //! Vertical Synchronization
     bool vsync;
+
+    //! Run as fast as possible (no pacing, no video, no audio)
+    bool maxSpeed;
     
     //! Number of run-ahead frames (0 = run-ahead is disabled)
     isize runAhead;
+
+    //! Emulate the drives on a separate thread
+    bool driveThread;
+
+    //! Synthesize the SID output on a separate thread
+    bool sidThread;
+
+    //! Number of execution slices per frame (1 = compute whole frames)
+    isize slices;
+
+    //! Execute the cycles between two events without checking for events
+    bool blockExec;
 }
 C64Config;
 
@@ -375,6 +390,7 @@ constexpr u32 SINGLE_STEP   = (1 << 6);
 constexpr u32 SINGLE_CYCLE  = (1 << 7);
 constexpr u32 FINISH_LINE   = (1 << 8);
 constexpr u32 FINISH_FRAME  = (1 << 9);
+constexpr u32 DRIVE_WAKEUP  = (1 << 10);
 }
 
 }
@@ -166,12 +166,31 @@ CIA::scheduleWakeUp()
 void
 CIA::executeOneCycle()
 {
-    // Make a local copy for speed
-    u64 delay = this->delay;
-    
     u64 oldDelay = delay;
     u64 oldFeed  = feed;
-    
+
+    emulateCycle();
+
+    // Get tired if nothing has happened in this cycle
+    if (oldDelay == delay && oldFeed == feed) tiredness++; else tiredness = 0;
+
+    // Sleep when threshold is reached
+    if (tiredness > 8 && config.idleSleep) {
+
+        sleep();
+        if (sleeping) { scheduleWakeUp(); return; }
+    }
+
+    // Schedule the next event
+    scheduleNextExecution();
+}
+
+void
+CIA::emulateCycle()
+{
+    // Make a local copy for speed
+    u64 delay = this->delay;
+
     //
     // Layout of timer (A and B)
     //
@@ -485,22 +504,99 @@ CIA::executeOneCycle()
 
     // Move delay flags left and feed in new bits
     delay = ((delay << 1) & CIADelayMask) | feed;
-    
-    // Get tired if nothing has happened in this cycle
-    if (oldDelay == delay && oldFeed == feed) tiredness++; else tiredness = 0;
-    
+
     // Write back local copy
     this->delay = delay;
+}
 
-    // Sleep when threshold is reached
-    if (tiredness > 8 && config.idleSleep) {
+/* Closed-form timer model
+ *
+ * Once a timer is running continuously, its counter follows a fixed pattern.
+ * Starting with value 'counter', the timer underflows after 'counter' cycles.
+ * In the underflow cycle, the counter is reloaded with 'latch' and it pauses
+ * for one cycle before it continues to count down. Hence, all subsequent
+ * underflows happen every 'latch + 1' cycles.
+ */
+static inline i64
+underflows(u16 counter, u16 latch, Cycle elapsed)
+{
+    return elapsed < counter ? 0 : 1 + (elapsed - counter) / (latch + 1);
+}
 
-        sleep();
-        if (sleeping) { scheduleWakeUp(); return; }
-    }
+static inline Cycle
+cyclesSinceUnderflow(u16 counter, u16 latch, Cycle elapsed)
+{
+    return (elapsed - counter) % (latch + 1);
+}
 
-    // Schedule the next event
-    scheduleNextExecution();
+static inline u16
+counterValue(u16 counter, u16 latch, Cycle elapsed)
+{
+    if (elapsed < counter) return u16(counter - elapsed);
+    return u16(latch - std::max(cyclesSinceUnderflow(counter, latch, elapsed) - 1, Cycle(0)));
+}
+
+bool
+CIA::isCascading() const
+{
+    return (CRB & 0x61) == 0x41 || ((CRB & 0x61) == 0x61 && CNT);
+}
+
+bool
+CIA::canSkipUnderflowsA() const
+{
+    // The timer must count system cycles in continuous mode
+    if (!(feed & CIACountA0) || ((delay | feed) & CIAOneShotA0)) return false;
+
+    // Short periods never let the delay pipe settle down
+    if (latchA < 8) return false;
+
+    // The serial register is clocked by timer A in output mode
+    if (CRA & 0x40) return false;
+
+    // Interrupts must be raised in the correct cycle
+    return !(imr & 0x01) || (INT == 0 && (icr & 0x80));
+}
+
+bool
+CIA::canSkipUnderflowsB() const
+{
+    // The timer must count system cycles in continuous mode
+    if (!(feed & CIACountB0) || ((delay | feed) & CIAOneShotB0)) return false;
+
+    // Short periods never let the delay pipe settle down
+    if (latchB < 8) return false;
+
+    // Interrupts must be raised in the correct cycle
+    return !(imr & 0x02) || (INT == 0 && (icr & 0x80));
+}
+
+void
+CIA::skipUnderflows(u8 bit, u8 cr, i64 count)
+{
+    if (count == 0) return;
+
+    u8 pb = bit == 0x01 ? 0x40 : 0x80;
+
+    icr |= bit;
+    icrAck &= ~bit;
+
+    // Toggle the underflow bit once per underflow
+    if (count & 1) PB67Toggle ^= pb;
+
+    if (cr & 0x02) {
+
+        if (cr & 0x04) {
+
+            // Toggle mode
+            if (count & 1) PB67TimerOut ^= pb;
+
+        } else {
+
+            // Pulse mode (the pulse is over)
+            PB67TimerOut &= ~pb;
+        }
+    }
 }
 
 void
@@ -513,6 +609,22 @@ CIA::sleep()
     Cycle sleepA = cpu.clock + ((counterA > 3) ? (counterA - 2) : 0);
     Cycle sleepB = cpu.clock + ((counterB > 3) ? (counterB - 2) : 0);
 
+    // Timers with predictable underflows can sleep through them
+    if (canSkipUnderflowsA()) {
+
+        if (isCascading()) {
+
+            // Wake up before timer B underflows
+            auto cycles = counterA + Cycle(counterB) * (latchA + 1);
+            sleepA = cpu.clock + ((cycles > 3) ? (cycles - 2) : 0);
+
+        } else {
+
+            sleepA = INT64_MAX;
+        }
+    }
+    if (canSkipUnderflowsB()) sleepB = INT64_MAX;
+
     // CIAs with stopped timers can sleep forever
     if ((feed & CIACountA) == 0) sleepA = INT64_MAX;
     if ((feed & CIACountB) == 0) sleepB = INT64_MAX;
@@ -536,31 +648,88 @@ CIA::wakeUp()
     if (!sleeping) return;
     sleeping = false;
 
+    auto runningA = bool(feed & CIACountA0);
+    auto runningB = bool(feed & CIACountB0);
+
+    /* An underflow leaves transient bits in the delay pipe for three cycles.
+     * If we wake up inside such a window, we compute the state up to the
+     * cycle before the underflow and emulate the remaining cycles.
+     */
+    auto settle = [&](u16 counter, u16 latch, Cycle cycle) {
+
+        auto elapsed = cycle - sleepCycle;
+        if (underflows(counter, latch, elapsed) == 0) return cycle;
+
+        auto phase = cyclesSinceUnderflow(counter, latch, elapsed);
+        return phase >= 3 ? cycle : cycle - phase - 1;
+    };
+
+    Cycle resume = cpu.clock;
+    for (Cycle cycle = INT64_MAX; cycle != resume; ) {
+
+        cycle = resume;
+        if (runningA) resume = settle(counterA, latchA, resume);
+        if (runningB) resume = settle(counterB, latchB, resume);
+    }
+
     // Calculate the number of missed cycles
     wakeUpCycle = cpu.clock;
-    Cycle missedCycles = wakeUpCycle - sleepCycle;
-    
+    Cycle missedCycles = resume - sleepCycle;
+
     // Make up for missed cycles
     if (missedCycles > 0) {
-        
-        if (feed & CIACountA0) {
 
-            assert(counterA >= missedCycles);
-            counterA -= u16(missedCycles);
+        i64 underflowsA = 0, underflowsB = 0;
+
+        if (runningA) {
+
+            underflowsA = underflows(counterA, latchA, missedCycles);
+            counterA = counterValue(counterA, latchA, missedCycles);
+            skipUnderflows(0x01, CRA, underflowsA);
         }
-        if (feed & CIACountB0) {
+        if (runningB) {
+
+            underflowsB = underflows(counterB, latchB, missedCycles);
+            counterB = counterValue(counterB, latchB, missedCycles);
+            skipUnderflows(0x02, CRB, underflowsB);
 
-            assert(counterB >= missedCycles);
-            counterB -= u16(missedCycles);
+        } else if (isCascading()) {
+
+            assert(counterB >= underflowsA);
+            counterB -= u16(underflowsA);
         }
-        
+
         idleCycles += missedCycles;
     }
 
+    // Emulate the cycles we've stopped short of
+    for (Cycle i = resume; i < wakeUpCycle; i++) emulateCycle();
+
     // Schedule the next execution event
     scheduleNextExecution();
 }
 
+u16
+CIA::getCounterA() const
+{
+    if (isSleeping() && (feed & CIACountA0)) {
+        return counterValue(counterA, latchA, idleSince());
+    }
+    return counterA;
+}
+
+u16
+CIA::getCounterB() const
+{
+    if (isSleeping() && (feed & CIACountB0)) {
+        return counterValue(counterB, latchB, idleSince());
+    }
+    if (isSleeping() && (feed & CIACountA0) && isCascading()) {
+        return u16(counterB - underflows(counterA, latchA, idleSince()));
+    }
+    return counterB;
+}
+
 Cycle
 CIA::idleSince() const
 {
@@ -797,9 +966,19 @@ CIA2::computePB() const
     return parCable.getValue();
 }
 
+u8
+CIA2::peekPA()
+{
+    // Let the drives catch up before the IEC bus is sampled
+    c64.driveThread.sync();
+
+    return CIA::peekPA();
+}
+
 void
 CIA2::pokePRA(u8 value)
 {
+    c64.driveThread.sync();
     CIA::pokePRA(value);
     
     // PA0 (VA14) and PA1 (VA15) determine the memory bank seen by VICII
@@ -818,6 +997,7 @@ CIA2::pokePRB(u8 value)
 void
 CIA2::pokeDDRA(u8 value)
 {
+    c64.driveThread.sync();
     CIA::pokeDDRA(value);
     
     // PA0 (VA14) and PA1 (VA15) determine the memory bank seen by VICII
@@ -572,6 +572,11 @@ public:
     // Executes the CIA for one cycle
     void executeOneCycle();
 
+private:
+
+    // Emulates the chip logic for a single cycle
+    void emulateCycle();
+
     
     //
     // Speeding up (sleep logic)
@@ -581,7 +586,20 @@ private:
     
     // Puts the CIA into idle state
     void sleep();
-    
+
+    // Checks if timer B counts the underflows of timer A
+    bool isCascading() const;
+
+    /* Checks if the underflows of a timer can be computed in closed form.
+     * This is the case for timers counting system cycles in continuous mode
+     * unless an underflow has to trigger an interrupt.
+     */
+    bool canSkipUnderflowsA() const;
+    bool canSkipUnderflowsB() const;
+
+    // Applies the side effects of skipped underflows to ICR and PB6 / PB7
+    void skipUnderflows(u8 bit, u8 cr, i64 count);
+
 public:
 
     // Emulates all previously skipped cycles
@@ -598,6 +616,10 @@ public:
     
     // Total number of cycles the CIA was idle
     Cycle idleTotal() const { return idleCycles; }
+
+    // Returns the current timer values without waking up the CIA
+    u16 getCounterA() const;
+    u16 getCounterB() const;
 };
 
 
@@ -652,13 +674,17 @@ public:
     
     void updatePA() override;
     u8 computePA() const override;
-    
+
+    // Recomputes port A without scheduling a bus update
+    void refreshPA() { PA = computePA(); }
+
 private:
     
     u8 portBinternal() const override;
     u8 portBexternal() const override;
     void updatePB() override;
     u8 computePB() const override;
+    u8 peekPA() override;
     void pokePRA(u8 value) override;
     void pokePRB(u8 value) override;
     void pokeDDRA(u8 value) override;
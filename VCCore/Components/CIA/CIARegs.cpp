@@ -147,8 +147,6 @@ CIA::peek(u16 addr)
 u8
 CIA::spypeek(u16 addr) const
 {
-    bool running;
-
     assert(addr <= 0x000F);
     switch(addr) {
 
@@ -165,20 +163,16 @@ CIA::spypeek(u16 addr) const
             return DDRB;
             
         case 0x04: // CIA_TIMER_A_LOW
-            running = delay & CIACountA3;
-            return LO_BYTE(counterA - (running ? (u16)idleSince() : 0));
+            return LO_BYTE(getCounterA());
             
         case 0x05: // CIA_TIMER_A_HIGH
-            running = delay & CIACountA3;
-            return HI_BYTE(counterA - (running ? (u16)idleSince() : 0));
+            return HI_BYTE(getCounterA());
             
         case 0x06: // CIA_TIMER_B_LOW
-            running = delay & CIACountB3;
-            return LO_BYTE(counterB - (running ? (u16)idleSince() : 0));
+            return LO_BYTE(getCounterB());
             
         case 0x07: // CIA_TIMER_B_HIGH
-            running = delay & CIACountB3;
-            return HI_BYTE(counterB - (running ? (u16)idleSince() : 0));
+            return HI_BYTE(getCounterB());
             
         case 0x08: // CIA_TIME_OF_DAY_SEC_FRAC
             return tod.getTodTenth();
@@ -39,6 +39,7 @@ CPU::writePort(u8 val)
 
     // When writing to the port register, the last VICII byte appears
     mem.ram[0x0001] = vic.getDataBusPhi1();
+    mem.dirtyRam.mark(0);
 
     // Switch memory banks
     mem.updatePeekPokeLookupTables();
@@ -68,6 +69,7 @@ CPU::writePortDir(u8 val)
 
     // When writing to the direction register, the last VICII byte appears
     mem.ram[0x0000] = vic.getDataBusPhi1();
+    mem.dirtyRam.mark(0);
 
     // Switch memory banks
     mem.updatePeekPokeLookupTables();
@@ -134,7 +136,7 @@ CPU::watchpointReached(u16 addr) const
 void
 CPU::instructionLogged() const
 {
-
+    if (tracer.traces(*this)) tracer.record(*this);
 }
 
 void
@@ -143,6 +145,12 @@ CPU::jumpedTo(u16 addr) const
     msgQueue.put(Msg::CPU_JUMPED, CpuMsg { .pc = addr } );
 }
 
+void
+CPU::trapReached(u16 addr)
+{
+    if (isC64CPU()) vdrive.processTrap(addr);
+}
+
 void
 CPU::jump(u16 addr)
 {
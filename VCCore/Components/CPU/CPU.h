@@ -83,6 +83,7 @@ public:
     bool isDriveCPU() const { return cpuModel == CPURevision::MOS_6502; }
 
     void setID(isize id) { this->id = id; }
+    isize getID() const { return id; }
 
     CPU& operator= (const CPU& other) {
 
@@ -229,6 +230,7 @@ public:
     virtual void watchpointReached(u16 addr) const override;
     virtual void instructionLogged() const override;
     virtual void jumpedTo(u16 addr) const override;
+    virtual void trapReached(u16 addr) override;
 
 
     //
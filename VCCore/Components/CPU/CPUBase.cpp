@@ -65,6 +65,7 @@ CPU::_dump(Category category, std::ostream &os) const
         if (flags & CPU_LOG_INSTRUCTION) str = append(str, "LOG_INSTRUCTION");
         if (flags & CPU_CHECK_BP) str = append(str, "CHECK_BP");
         if (flags & CPU_CHECK_WP) str = append(str, "CHECK_WP");
+        if (flags & CPU_CHECK_TRAP) str = append(str, "CHECK_TRAP");
 
         os << tab("Clock");
         os << dec(clock) << std::endl;
@@ -160,7 +161,7 @@ CPU::_didReset(bool hard)
     Peddle::reset();
 
     // Enable or disable CPU debugging
-    c64.emulator.isTracking() ? debugger.enableLogging() : debugger.disableLogging();
+    c64.emulator.isTracking() || tracer.traces(*this) ? debugger.enableLogging() : debugger.disableLogging();
 
     assert(levelDetector.isClear());
     assert(edgeDetector.isClear());
@@ -178,7 +179,8 @@ CPU::_trackOn()
 void
 CPU::_trackOff()
 {
-    debugger.disableLogging();
+    // Keep logging if the instructions are streamed into a trace file
+    if (!tracer.traces(*this)) debugger.disableLogging();
 }
 
 i64
@@ -12,6 +12,7 @@
 #include "PeddleDisassembler.h"
 #include "SymbolTable.h"
 #include "PeddleDebugger.h"
+#include "PeddleProfiler.h"
 #include "SubComponent.h"
 #include "PeddleUtils.h"
 #include "TimeDelayed.h"
@@ -21,6 +22,7 @@ namespace vc64::peddle {
 class Peddle : public SubComponent {
 
     friend class Debugger;
+    friend class Profiler;
     friend class Disassembler;
     friend class Breakpoints;
     friend class Watchpoints;
@@ -61,6 +63,7 @@ protected:
 public:
 
     Debugger debugger = Debugger(*this);
+    Profiler profiler = Profiler(*this);
     Disassembler disassembler = Disassembler(*this);
     SymbolTable symbolTable = SymbolTable();
 
@@ -111,6 +114,9 @@ protected:
      */
     u8 rdyLine;
 
+    // Number of cycles the CPU has been frozen by the RDY line (statistics)
+    i64 stalledCycles = 0;
+
     // Cycle of the most recent rising edge of the RDY line
     i64 rdyLineUp;
 
@@ -275,6 +281,13 @@ public:
     void finishInstruction();
     template <CPURevision C> void finishInstruction();
 
+    // Enables or disables the trap delegate
+    void enableTraps() { flags |= CPU_CHECK_TRAP; }
+    void disableTraps() { flags &= ~CPU_CHECK_TRAP; }
+
+    // Indicates if any debug or trap flag is set
+    bool isObserved() const { return flags != 0; }
+
 protected:
 
     // Called after the last microcycle has been completed
@@ -430,6 +443,9 @@ protected:
     virtual void instructionLogged() const { }
     virtual void jumpedTo(u16 addr) const { }
 
+    // Trap delegate (may modify the registers to skip a routine)
+    virtual void trapReached(u16 addr) { }
+
 
     //
     // Operating the Arithmetical Logical Unit (ALU)
@@ -56,6 +56,8 @@ Guards::guardNr(long nr) const
 Guard *
 Guards::guardAt(u32 addr) const
 {
+    if (!isMarked(addr)) return nullptr;
+
     for (int i = 0; i < count; i++) {
         if (guards[i].addr == addr) return &guards[i];
     }
@@ -82,6 +84,7 @@ Guards::setAt(u32 addr, long skip)
     guards[count].hits = 0;
     guards[count].ignore = skip;
     count++;
+    bitmap[(addr >> 6) & 1023] |= u64(1) << (addr & 63);
     setNeedsCheck(true);
 }
 
@@ -103,6 +106,7 @@ Guards::removeAt(u32 addr)
             break;
         }
     }
+    updateBitmap();
     setNeedsCheck(count != 0);
 }
 
@@ -111,6 +115,7 @@ Guards::moveTo(long nr, u32 newAddr)
 {
     if (nr >= count || isSetAt(newAddr)) return;
     guards[nr].moveTo(newAddr);
+    updateBitmap();
 }
 
 bool
@@ -173,10 +178,21 @@ Guards::ignore(long nr, long count)
 bool
 Guards::eval(u32 addr)
 {
-    for (int i = 0; i < count; i++)
-        if (guards[i].eval(addr)) return true;
+    // Most accesses don't hit a guard
+    if (!isMarked(addr)) return false;
 
-    return false;
+    Guard *guard = guardAt(addr);
+    return guard != nullptr && guard->eval(addr);
+}
+
+void
+Guards::updateBitmap()
+{
+    for (auto &word : bitmap) word = 0;
+
+    for (int i = 0; i < count; i++) {
+        bitmap[(guards[i].addr >> 6) & 1023] |= u64(1) << (guards[i].addr & 63);
+    }
 }
 
 void
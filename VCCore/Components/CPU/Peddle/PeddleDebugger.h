@@ -31,6 +31,14 @@ protected:
     // Number of currently stored guards
     long count = 0;
 
+    /* Presence bitmap with one bit for each address in the 64 KB address
+     * space. A bit is set if a guard exists at the corresponding address.
+     * Because guards are checked on each instruction fetch or memory access,
+     * the bitmap lets us answer the common case (no guard) with a single bit
+     * test. The guard array is only searched if the bit is set.
+     */
+    u64 bitmap[1024] = { };
+
     // Indicates if guard checking is necessary
     virtual void setNeedsCheck(bool value) = 0;
     
@@ -68,7 +76,7 @@ public:
 
     void remove(long nr);
     void removeAt(u32 addr);
-    void removeAll() { count = 0; setNeedsCheck(false); }
+    void removeAll() { count = 0; updateBitmap(); setNeedsCheck(false); }
 
 
     //
@@ -103,6 +111,13 @@ private:
     
     // Returns true if the guard hits
     bool eval(u32 addr);
+
+    // Checks if a guard might exist at the specified address
+    bool isMarked(u32 addr) const {
+        return bitmap[(addr >> 6) & 1023] & (u64(1) << (addr & 63)); }
+
+    // Rebuilds the presence bitmap
+    void updateBitmap();
 };
 
 class Breakpoints : public Guards {
@@ -60,57 +60,60 @@ Peddle::concludeRead(u8 x)
 
 #endif
 
+// Freezes the CPU for the current cycle (RDY line low)
+#define STALL { stalledCycles++; return; }
+
 #define FETCH_IR \
-if (likely(!rdyLine)) { LATCH_INSTR(read<C>(reg.pc++)); } else return;
+if (likely(!rdyLine)) { LATCH_INSTR(read<C>(reg.pc++)); } else STALL;
 #define FETCH_ADDR_LO \
-if (likely(!rdyLine)) { LATCH_ADL(read<C>(reg.pc++)); } else return;
+if (likely(!rdyLine)) { LATCH_ADL(read<C>(reg.pc++)); } else STALL;
 #define FETCH_ADDR_HI \
-if (likely(!rdyLine)) { LATCH_ADH(read<C>(reg.pc++)); } else return;
+if (likely(!rdyLine)) { LATCH_ADH(read<C>(reg.pc++)); } else STALL;
 #define FETCH_POINTER_ADDR \
-if (likely(!rdyLine)) { LATCH_IDL(read<C>(reg.pc++)); } else return;
+if (likely(!rdyLine)) { LATCH_IDL(read<C>(reg.pc++)); } else STALL;
 #define FETCH_ADDR_LO_INDIRECT \
-if (likely(!rdyLine)) { LATCH_ADL(read<C>((u16)reg.idl++)); } else return;
+if (likely(!rdyLine)) { LATCH_ADL(read<C>((u16)reg.idl++)); } else STALL;
 #define FETCH_ADDR_HI_INDIRECT \
-if (likely(!rdyLine)) { LATCH_ADH(read<C>((u16)reg.idl++)); } else return;
+if (likely(!rdyLine)) { LATCH_ADH(read<C>((u16)reg.idl++)); } else STALL;
 #define IDLE_FETCH \
-if (likely(!rdyLine)) readIdle<C>(reg.pc); else return;
+if (likely(!rdyLine)) readIdle<C>(reg.pc); else STALL;
 
 #define READ_RELATIVE \
-if (likely(!rdyLine)) { LATCH_D(read<C>(reg.pc)); } else return;
+if (likely(!rdyLine)) { LATCH_D(read<C>(reg.pc)); } else STALL;
 #define READ_IMMEDIATE \
-if (likely(!rdyLine)) { LATCH_D(read<C>(reg.pc++)); } else return;
+if (likely(!rdyLine)) { LATCH_D(read<C>(reg.pc++)); } else STALL;
 #define READ_FROM(x) \
-if (likely(!rdyLine)) { LATCH_D(read<C>(x)); } else return;
+if (likely(!rdyLine)) { LATCH_D(read<C>(x)); } else STALL;
 #define READ_FROM_ADDRESS \
-if (likely(!rdyLine)) { LATCH_D(read<C>(HI_LO(reg.adh, reg.adl))); } else return;
+if (likely(!rdyLine)) { LATCH_D(read<C>(HI_LO(reg.adh, reg.adl))); } else STALL;
 #define READ_FROM_ZERO_PAGE \
-if (likely(!rdyLine)) { LATCH_D(readZeroPage<C>(reg.adl)); } else return;
+if (likely(!rdyLine)) { LATCH_D(readZeroPage<C>(reg.adl)); } else STALL;
 #define READ_FROM_ADDRESS_INDIRECT \
-if (likely(!rdyLine)) { LATCH_D(readZeroPage<C>(reg.dl)); } else return;
+if (likely(!rdyLine)) { LATCH_D(readZeroPage<C>(reg.dl)); } else STALL;
 
 #define IDLE_READ_IMPLIED \
-if (likely(!rdyLine)) readIdle<C>(reg.pc); else return;
+if (likely(!rdyLine)) readIdle<C>(reg.pc); else STALL;
 #define IDLE_READ_IMMEDIATE \
-if (likely(!rdyLine)) readIdle<C>(reg.pc++); else return;
+if (likely(!rdyLine)) readIdle<C>(reg.pc++); else STALL;
 #define IDLE_READ_FROM(x) \
-if (likely(!rdyLine)) readIdle<C>(x); else return;
+if (likely(!rdyLine)) readIdle<C>(x); else STALL;
 #define IDLE_READ_FROM_ADDRESS \
-if (likely(!rdyLine)) readIdle<C>(HI_LO(reg.adh, reg.adl)); else return;
+if (likely(!rdyLine)) readIdle<C>(HI_LO(reg.adh, reg.adl)); else STALL;
 #define IDLE_READ_FROM_ZERO_PAGE \
-if (likely(!rdyLine)) readZeroPageIdle<C>(reg.adl); else return;
+if (likely(!rdyLine)) readZeroPageIdle<C>(reg.adl); else STALL;
 #define IDLE_READ_FROM_ADDRESS_INDIRECT \
-if (likely(!rdyLine)) readZeroPageIdle<C>(reg.idl); else return;
+if (likely(!rdyLine)) readZeroPageIdle<C>(reg.idl); else STALL;
 
 #define PULL_PCL if \
-(likely(!rdyLine)) { LATCH_PCL(readStack<C>(reg.sp)); } else return;
+(likely(!rdyLine)) { LATCH_PCL(readStack<C>(reg.sp)); } else STALL;
 #define PULL_PCH \
-if (likely(!rdyLine)) { LATCH_PCH(readStack<C>(reg.sp)); } else return;
+if (likely(!rdyLine)) { LATCH_PCH(readStack<C>(reg.sp)); } else STALL;
 #define PULL_P \
-if (likely(!rdyLine)) { LATCH_P(readStack<C>(reg.sp)); } else return;
+if (likely(!rdyLine)) { LATCH_P(readStack<C>(reg.sp)); } else STALL;
 #define PULL_A \
-if (likely(!rdyLine)) { LATCH_A(readStack<C>(reg.sp)); } else return;
+if (likely(!rdyLine)) { LATCH_A(readStack<C>(reg.sp)); } else STALL;
 #define IDLE_PULL \
-if (likely(!rdyLine)) { readStackIdle<C>(reg.sp); } else return;
+if (likely(!rdyLine)) { readStackIdle<C>(reg.sp); } else STALL;
 
 // Write
 
@@ -3185,6 +3188,16 @@ Peddle::done() {
 
     if (flags) {
 
+        if (flags & CPU_PROFILE) {
+
+            profiler.record();
+        }
+
+        if (flags & CPU_CHECK_TRAP) {
+
+            trapReached(reg.pc);
+        }
+
         if (flags & CPU_LOG_INSTRUCTION) {
 
             debugger.logInstruction();
@@ -0,0 +1,268 @@
+// -----------------------------------------------------------------------------
+// This file is part of Peddle - A MOS 65xx CPU emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Published under the terms of the MIT License
+// -----------------------------------------------------------------------------
+
+#include "PeddleConfig.h"
+#include "Peddle.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace vc64::peddle {
+
+//
+// Controlling
+//
+
+bool
+Profiler::isEnabled() const
+{
+    return cpu.flags & CPU_PROFILE;
+}
+
+void
+Profiler::enable()
+{
+    init();
+
+    // Start a new frame chain at the root, as we don't know the call history
+    stack.clear();
+    current = 0;
+
+    lastClock = cpu.clock;
+    lastStalls = cpu.stalledCycles;
+
+    cpu.flags |= CPU_PROFILE;
+}
+
+void
+Profiler::disable()
+{
+    cpu.flags &= ~CPU_PROFILE;
+}
+
+void
+Profiler::clear()
+{
+    flat.clear();
+    nodes.clear();
+    children.clear();
+    stack.clear();
+    current = 0;
+
+    if (isEnabled()) enable();
+}
+
+
+//
+// Recording
+//
+
+void
+Profiler::init()
+{
+    if (flat.empty()) flat.assign(0x10000, Entry { });
+    if (nodes.empty()) nodes.push_back(Node { .entry = 0, .irq = false, .parent = -1 });
+}
+
+void
+Profiler::record()
+{
+    // The flag might have been set by loading a snapshot
+    if (nodes.empty()) init();
+
+    auto cycles = cpu.clock - lastClock;
+    auto stalls = cpu.stalledCycles - lastStalls;
+    lastClock = cpu.clock;
+    lastStalls = cpu.stalledCycles;
+
+    // Ignore the gap caused by a reset or a restored snapshot
+    if (cycles < 0 || stalls < 0 || stalls > cycles) cycles = stalls = 0;
+
+    auto pc = cpu.reg.pc0;
+    auto interrupt = cpu.next == irq_7 || cpu.next == nmi_7;
+
+    // Charge the interrupt sequence to the interrupt handler
+    if (interrupt) {
+
+        pc = cpu.reg.pc;
+        enter(pc, true, u8(cpu.reg.sp + 3));
+    }
+
+    auto &entry = flat[pc];
+    entry.cycles += cycles;
+    entry.stalls += stalls;
+    entry.count++;
+
+    auto &node = nodes[current];
+    node.cycles += cycles;
+    node.stalls += stalls;
+
+    if (interrupt) return;
+
+    switch (cpu.reg.ir) {
+
+        case 0x20: enter(cpu.reg.pc, false, u8(cpu.reg.sp + 2)); break; // JSR
+        case 0x00: enter(cpu.reg.pc, true, u8(cpu.reg.sp + 3)); break;  // BRK
+
+        case 0x40: // RTI
+        case 0x60: // RTS
+        case 0x9A: // TXS
+
+            leave(cpu.reg.sp);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void
+Profiler::enter(u16 entry, bool irq, u8 sp)
+{
+    // Start over if the stack has run away (e.g., code that never returns)
+    if (isize(stack.size()) >= maxDepth) { stack.clear(); current = 0; }
+
+    auto key = u64(current) << 17 | u64(irq) << 16 | entry;
+    isize child;
+
+    if (auto it = children.find(key); it != children.end()) {
+
+        child = it->second;
+
+    } else {
+
+        child = isize(nodes.size());
+        nodes.push_back(Node { .entry = entry, .irq = irq, .parent = current });
+        children[key] = child;
+    }
+
+    nodes[child].calls++;
+    stack.push_back(Frame { child, sp });
+    current = child;
+}
+
+void
+Profiler::leave(u8 sp)
+{
+    // Pop all frames whose return address has been pulled off the stack
+    while (!stack.empty() && stack.back().sp <= sp) stack.pop_back();
+
+    current = stack.empty() ? 0 : stack.back().node;
+}
+
+
+//
+// Exporting
+//
+
+i64
+Profiler::totalCycles() const
+{
+    i64 result = 0;
+    for (auto &node : nodes) result += node.cycles;
+    return result;
+}
+
+void
+Profiler::dumpFlat(std::ostream &os, isize count) const
+{
+    using namespace std;
+
+    auto total = totalCycles();
+    auto percent = [&](i64 value) { return total ? 100.0 * double(value) / double(total) : 0.0; };
+
+    i64 stalls = 0;
+    for (auto &node : nodes) stalls += node.stalls;
+
+    os << "Total: " << total << " cycles (" << stalls << " stalled)" << endl;
+
+    // Collect the most expensive instructions
+    vector<isize> pcs;
+    for (isize i = 0; i < isize(flat.size()); i++) if (flat[i].count) pcs.push_back(i);
+
+    auto n = std::min(count, isize(pcs.size()));
+    partial_sort(pcs.begin(), pcs.begin() + n, pcs.end(), [&](isize a, isize b) {
+        return flat[a].cycles > flat[b].cycles;
+    });
+
+    os << endl;
+    os << setw(12) << right << "Cycles" << setw(8) << "%";
+    os << setw(12) << "Stalls" << setw(12) << "Count" << "  Instruction" << endl;
+
+    for (isize i = 0; i < n; i++) {
+
+        auto &e = flat[pcs[i]];
+        os << setw(12) << right << e.cycles;
+        os << setw(8) << fixed << setprecision(2) << percent(e.cycles);
+        os << setw(12) << e.stalls << setw(12) << e.count;
+        os << "  " << symbolize(u16(pcs[i])) << endl;
+    }
+
+    // Accumulate the self cycles of all routines across the call tree
+    std::unordered_map<u32, Node> routines;
+    for (isize i = 1; i < isize(nodes.size()); i++) {
+
+        auto &node = nodes[i];
+        auto &r = routines[u32(node.irq) << 16 | node.entry];
+        r.entry = node.entry;
+        r.irq = node.irq;
+        r.cycles += node.cycles;
+        r.stalls += node.stalls;
+        r.calls += node.calls;
+    }
+
+    vector<Node> sorted;
+    for (auto &it : routines) sorted.push_back(it.second);
+
+    n = std::min(count, isize(sorted.size()));
+    partial_sort(sorted.begin(), sorted.begin() + n, sorted.end(), [](auto &a, auto &b) {
+        return a.cycles > b.cycles;
+    });
+
+    os << endl;
+    os << setw(12) << right << "Self" << setw(8) << "%";
+    os << setw(12) << "Stalls" << setw(12) << "Calls" << "  Routine" << endl;
+
+    for (isize i = 0; i < n; i++) {
+
+        auto &r = sorted[i];
+        os << setw(12) << right << r.cycles;
+        os << setw(8) << fixed << setprecision(2) << percent(r.cycles);
+        os << setw(12) << r.stalls << setw(12) << r.calls;
+        os << "  " << (r.irq ? "irq:" : "") << symbolize(r.entry) << endl;
+    }
+}
+
+void
+Profiler::dumpCollapsed(std::ostream &os) const
+{
+    for (isize i = 0; i < isize(nodes.size()); i++) {
+
+        if (nodes[i].cycles) os << stackOf(i) << ' ' << nodes[i].cycles << '\n';
+    }
+}
+
+string
+Profiler::symbolize(u16 addr) const
+{
+    if (auto symbol = cpu.symbolTable.symbols.seek(addr); symbol) return symbol->name;
+
+    std::stringstream ss;
+    ss << '$' << std::hex << std::uppercase << std::setw(4) << std::setfill('0') << addr;
+    return ss.str();
+}
+
+string
+Profiler::stackOf(isize node) const
+{
+    if (node <= 0) return "[root]";
+
+    auto &n = nodes[node];
+    return stackOf(n.parent) + ';' + (n.irq ? "irq:" : "") + symbolize(n.entry);
+}
+
+}
@@ -0,0 +1,158 @@
+// -----------------------------------------------------------------------------
+// This file is part of Peddle - A MOS 65xx CPU emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Published under the terms of the MIT License
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "PeddleTypes.h"
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace vc64::peddle {
+
+/* The profiler attributes elapsed clock cycles to the executed instructions
+ * and to the subroutines they belong to. It is invoked by the CPU at the end
+ * of each instruction if the CPU_PROFILE flag is set. All cycles that passed
+ * since the previous instruction boundary are charged to the instruction,
+ * including the cycles the CPU was frozen by the RDY line (VICII badlines
+ * and sprite DMA). The stalled cycles are tracked separately as well.
+ *
+ * The call graph is derived from JSR/RTS pairs. Interrupts and BRK open a
+ * new frame, too, which is closed by RTI. Each frame records the stack
+ * pointer value that is restored by the matching return instruction. When a
+ * return instruction (or TXS) leaves the stack pointer at or above this
+ * value, the frame is popped. Hence, code that manipulates the stack to
+ * return to an outer routine is tracked correctly.
+ */
+class Profiler {
+
+    friend class Peddle;
+
+    // Reference to the connected CPU
+    class Peddle &cpu;
+
+public:
+
+    // Statistics of a single instruction address (flat profile)
+    struct Entry {
+
+        i64 cycles;
+        i64 stalls;
+        i64 count;
+    };
+
+    // Node of the call tree
+    struct Node {
+
+        // Entry address of the called routine
+        u16 entry;
+
+        // Indicates if the routine has been entered via an interrupt or BRK
+        bool irq;
+
+        // Index of the calling node (-1 for the root node)
+        isize parent;
+
+        // Cycles spent inside this routine, excluding called routines
+        i64 cycles;
+        i64 stalls;
+
+        // Number of times this routine has been entered
+        i64 calls;
+    };
+
+    // Maximum nesting depth (deeper frames are considered stack garbage)
+    static constexpr isize maxDepth = 256;
+
+private:
+
+    // Flat profile (allocated lazily when profiling is enabled)
+    std::vector<Entry> flat;
+
+    // Call tree (the first element is the root node)
+    std::vector<Node> nodes;
+
+    // Maps a (parent, irq, entry) triple to the corresponding child node
+    std::unordered_map<u64, isize> children;
+
+    // Call stack
+    struct Frame { isize node; u8 sp; };
+    std::vector<Frame> stack;
+
+    // The node the CPU is currently executing in
+    isize current = 0;
+
+    // Counter values at the previous instruction boundary
+    i64 lastClock = 0;
+    i64 lastStalls = 0;
+
+
+    //
+    // Constructing
+    //
+
+public:
+
+    Profiler(Peddle& ref) : cpu(ref) { }
+
+
+    //
+    // Controlling
+    //
+
+public:
+
+    bool isEnabled() const;
+    void enable();
+    void disable();
+
+    // Deletes all recorded data
+    void clear();
+
+
+    //
+    // Recording
+    //
+
+private:
+
+    // Allocates the profile buffers if not done yet
+    void init();
+
+    // Records the instruction that has just been completed
+    void record();
+
+    // Opens or closes a call frame
+    void enter(u16 entry, bool irq, u8 sp);
+    void leave(u8 sp);
+
+
+    //
+    // Exporting
+    //
+
+public:
+
+    // Returns the total number of recorded cycles
+    i64 totalCycles() const;
+
+    // Writes the 'count' most expensive instructions and routines
+    void dumpFlat(std::ostream &os, isize count = 16) const;
+
+    // Writes the call tree in collapsed stack format (flame graph input)
+    void dumpCollapsed(std::ostream &os) const;
+
+private:
+
+    // Returns a symbolic name for an address
+    string symbolize(u16 addr) const;
+
+    // Returns the semicolon-separated stack of a call tree node
+    string stackOf(isize node) const;
+};
+
+}
@@ -38,11 +38,23 @@ static constexpr isize N_FLAG = 0x80;
  *
  *    These flags indicate whether the CPU should check for breakpoints,
  *    watchpoints, or catchpoints.
+ *
+ * CPU_CHECK_TRAP:
+ *
+ *    This flag is set if the CPU should report each instruction boundary to
+ *    trapReached(). It allows the host to intercept ROM routines.
+ *
+ * CPU_PROFILE:
+ *
+ *    This flag is set if the profiler is enabled. If set, the CPU reports
+ *    each instruction boundary to the profiler.
  */
 static constexpr int CPU_LOG_INSTRUCTION    = (1 << 0);
 static constexpr int CPU_CHECK_BP           = (1 << 1);
 static constexpr int CPU_CHECK_WP           = (1 << 2);
 static constexpr int CPU_CHECK_CP           = (1 << 3);
+static constexpr int CPU_CHECK_TRAP         = (1 << 4);
+static constexpr int CPU_PROFILE            = (1 << 5);
 
 
 //
@@ -97,6 +97,7 @@ Memory::Memory(C64 &ref) : SubComponent(ref)
     for (isize i = 0x1; i <= 0xF; i++) {
         peekSrc[i] = pokeTarget[i] = MemType::RAM;
     }
+    updatePagePointers();
 }
 
 void
@@ -129,6 +130,8 @@ Memory::operator << (SerReader &worker)
 {
     serialize(worker);
     if (config.saveRoms) worker << rom;
+
+    updatePagePointers();
 }
 
 void 
@@ -203,6 +206,30 @@ Memory::eraseWithPattern(RamPattern pattern)
         default:
             fatalError;
     }
+
+    dirtyRam.markAll();
+}
+
+void
+Memory::syncWith(Memory &other)
+{
+    // Copy all pages that have been modified in either instance
+    auto pages = dirtyRam;
+    pages |= other.dirtyRam;
+    pages.forEach([&](isize nr) { memcpy(ram + 256 * nr, other.ram + 256 * nr, 256); });
+
+    dirtyRam.clear();
+    other.dirtyRam.clear();
+
+    // The ROMs can only be changed by API calls which enforce a full clone
+    CLONE_ARRAY(colorRam)
+
+    CLONE_ARRAY(peekSrc)
+    CLONE_ARRAY(pokeTarget)
+
+    CLONE(config)
+
+    updatePagePointers();
 }
 
 void 
@@ -223,6 +250,48 @@ Memory::updatePeekPokeLookupTables()
     
     // Call the Cartridge's delegation method
     expansionPort.updatePeekPokeLookupTables();
+
+    // Rebuild the fast path
+    updatePagePointers();
+}
+
+void
+Memory::updatePagePointers()
+{
+    for (isize page = 0; page < 256; page++) {
+
+        peekPtr[page] = pokePtr[page] = nullptr;
+
+        // Let the slow path record all accesses if the heatmap is enabled
+        if (config.heatmap) continue;
+
+        // The processor port registers live in the first page
+        bool port = page == 0;
+
+        switch (peekSrc[page >> 4]) {
+
+            case MemType::RAM:      peekPtr[page] = ram; break;
+            case MemType::BASIC:
+            case MemType::CHAR:
+            case MemType::KERNAL:   peekPtr[page] = rom; break;
+            case MemType::PP:       peekPtr[page] = port ? nullptr : ram; break;
+
+            default:
+                break;
+        }
+
+        switch (pokeTarget[page >> 4]) {
+
+            case MemType::RAM:
+            case MemType::BASIC:
+            case MemType::CHAR:
+            case MemType::KERNAL:   pokePtr[page] = ram; break;
+            case MemType::PP:       pokePtr[page] = port ? nullptr : ram; break;
+
+            default:
+                break;
+        }
+    }
 }
 
 u8
@@ -463,6 +532,7 @@ Memory::poke(u16 addr, u8 value, MemType target)
         case MemType::KERNAL:
             
             ram[addr] = value;
+            dirtyRam.mark(addr >> 8);
             return;
             
         case MemType::IO:
@@ -473,13 +543,16 @@ Memory::poke(u16 addr, u8 value, MemType target)
         case MemType::CRTLO:
         case MemType::CRTHI:
             
+            // Some cartridges write through to RAM
             expansionPort.poke(addr, value);
+            dirtyRam.mark(addr >> 8);
             return;
             
         case MemType::PP:
             
             if (likely(addr >= 0x02)) {
                 ram[addr] = value;
+                dirtyRam.mark(0);
             } else {
                 addr ? cpu.writePort(value) : cpu.writePortDir(value);
             }
@@ -511,6 +584,7 @@ Memory::pokeZP(u8 addr, u8 value)
 
     if (likely(addr >= 0x02)) {
         ram[addr] = value;
+        dirtyRam.mark(0);
     } else if (addr == 0x00) {
         cpu.writePortDir(value);
     } else {
@@ -524,6 +598,7 @@ Memory::pokeStack(u8 sp, u8 value)
     if (config.heatmap) stats.writes[sp]++;
 
     ram[0x100 + sp] = value;
+    dirtyRam.mark(1);
 }
 
 void
@@ -16,6 +16,7 @@
 #include "MemoryDebugger.h"
 #include "SubComponent.h"
 #include "Heatmap.h"
+#include "DirtyPages.h"
 
 namespace vc64 {
 
@@ -58,6 +59,9 @@ public:
     // Random Access Memory
     u8 ram[65536];
 
+    // Modified RAM pages (used to synchronize the run-ahead instance)
+    DirtyPages<256> dirtyRam;
+
     /* Color RAM
      * The color RAM is located in the I/O space, starting at $D800 and ending
      * at $DBFF. Only the lower four bits are accessible, the upper four bits
@@ -79,6 +83,16 @@ public:
     // Poke target lookup table
     MemType pokeTarget[16];
 
+    /* Page pointer tables. For each 256 byte page, these tables point to the
+     * array serving the accesses (ram or rom). The array is indexed with the
+     * full address. A nullptr sends the access down the slow path, which is
+     * the case for I/O, cartridge, and processor port pages and for all pages
+     * while the heatmap is recorded. The tables are derived from peekSrc and
+     * pokeTarget by updatePagePointers().
+     */
+    u8 *peekPtr[256] = { };
+    u8 *pokePtr[256] = { };
+
     // Indicates if watchpoints should be checked
     bool checkWatchpoints = false;
 
@@ -105,9 +119,13 @@ public:
 
         CLONE(config)
 
+        updatePagePointers();
         return *this;
     }
 
+    // Copies all RAM pages that differ from another instance
+    void syncWith(Memory &other);
+
 
     //
     // Methods from Serializable
@@ -194,6 +212,9 @@ public:
      */
     void updatePeekPokeLookupTables();
 
+    // Derives the page pointer tables from the peek and poke lookup tables
+    void updatePagePointers();
+
     // Returns the current peek source of the specified memory address
     MemType getPeekSource(u16 addr) { return peekSrc[addr >> 12]; }
 
@@ -203,7 +224,10 @@ public:
     // Reads a value from memory
     u8 peek(u16 addr, MemType source);
     u8 peek(u16 addr, bool gameLine, bool exromLine);
-    u8 peek(u16 addr) { return peek(addr, peekSrc[addr >> 12]); }
+    u8 peek(u16 addr) {
+        if (auto p = peekPtr[addr >> 8]) return p[addr];
+        return peek(addr, peekSrc[addr >> 12]);
+    }
     u8 peekZP(u8 addr);
     u8 peekStack(u8 sp);
     u8 peekIO(u16 addr);
@@ -223,7 +247,10 @@ public:
     // Writing a value into memory
     void poke(u16 addr, u8 value, MemType target);
     void poke(u16 addr, u8 value, bool gameLine, bool exromLine);
-    void poke(u16 addr, u8 value) { poke(addr, value, pokeTarget[addr >> 12]); }
+    void poke(u16 addr, u8 value) {
+        if (auto p = pokePtr[addr >> 8]) { p[addr] = value; dirtyRam.mark(addr >> 8); return; }
+        poke(addr, value, pokeTarget[addr >> 12]);
+    }
     void pokeZP(u8 addr, u8 value);
     void pokeStack(u8 sp, u8 value);
     void pokeIO(u16 addr, u8 value);
@@ -125,6 +125,7 @@ Memory::setOption(Opt opt, i64 value)
         case Opt::MEM_HEATMAP:
 
             config.heatmap = (bool)value;
+            updatePagePointers();
             return;
 
         case Opt::MEM_SAVE_ROMS:
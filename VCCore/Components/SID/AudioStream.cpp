@@ -16,153 +16,228 @@
 
 namespace vc64 {
 
+AudioStream::AudioStream(isize capacity) : capacity(capacity)
+{
+    elements = new SamplePair[capacity]();
+}
+
+AudioStream::~AudioStream()
+{
+    delete[] elements;
+}
+
+i64
+AudioStream::readPos() const
+{
+    // Samples the consumer has been asked to skip are considered consumed
+    return std::max(r.load(std::memory_order_acquire), skipTo.load(std::memory_order_acquire));
+}
+
+isize
+AudioStream::count() const
+{
+    auto rp = readPos();
+    auto wp = w.load(std::memory_order_acquire);
+
+    return std::clamp(isize(wp - rp), isize(0), capacity);
+}
+
+void
+AudioStream::write(SamplePair pair)
+{
+    auto wp = w.load(std::memory_order_relaxed);
+
+    // Drop the sample if no slot is free
+    if (wp - readPos() >= capacity) return;
+
+    elements[wp % capacity] = pair;
+    w.store(wp + 1, std::memory_order_release);
+}
+
+void
+AudioStream::pad(isize n)
+{
+    for (isize i = std::min(n, free()); i > 0; i--) write(SamplePair { 0, 0 });
+}
+
 void
 AudioStream::wipeOut()
 {
-    {   SYNCHRONIZED
+    skipTo.store(w.load(std::memory_order_relaxed), std::memory_order_release);
+}
 
-        clear(SamplePair{0,0});
-    }
+void
+AudioStream::trim(isize n)
+{
+    skipTo.store(w.load(std::memory_order_relaxed) - n, std::memory_order_release);
 }
 
 void
 AudioStream::eliminateCracks()
 {
-    {   SYNCHRONIZED
+    loginfo(AUDVOL_DEBUG, "Eliminating cracks (%ld samples)...\n", count());
 
-        loginfo(AUDVOL_DEBUG, "Eliminating cracks (%ld samples)...\n", count());
+    fade.store(true, std::memory_order_release);
+}
 
-        float scale = 1.0f;
-        float delta = 1.0f / count();
+void
+AudioStream::alignWritePtr()
+{
+    auto wp = w.load(std::memory_order_relaxed);
 
-        // Rescale the existing samples
-        for (isize i = begin(); i != end(); i = next(i)) {
+    pad(capacity / 2 - isize(wp - readPos()));
+}
 
-            scale -= delta;
-            assert(scale >= -0.1 && scale < 1.0);
+i64
+AudioStream::beginRead(i64 &end)
+{
+    auto rp = r.load(std::memory_order_relaxed);
+    end = w.load(std::memory_order_acquire);
 
-            elements[i].l *= scale;
-            elements[i].r *= scale;
-        }
+    // Discard samples if requested by the producer
+    if (auto pos = skipTo.load(std::memory_order_acquire); pos > rp) {
+        rp = std::min(pos, end);
+    }
+
+    // Fade out the buffered samples if requested by the producer
+    if (fade.exchange(false, std::memory_order_acquire)) {
 
-        // Wipe out the rest of the buffer
-        for (isize i = end(); i != begin(); i = next(i)) {
+        float scale = 1.0f;
+        float delta = 1.0f / float(std::max(end - rp, i64(1)));
 
-            elements[i] = { 0, 0 };
+        for (i64 i = rp; i < end; i++) {
+
+            scale -= delta;
+            elements[i % capacity].l *= scale;
+            elements[i % capacity].r *= scale;
         }
     }
+
+    // Record the current latency
+    auto ms = isize(double(end - rp) * 1000.0 / sampleRate.load(std::memory_order_relaxed));
+    auto bucket = std::min(ms / latencyBucketWidth, latencyBuckets - 1);
+    latency[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    return rp;
 }
 
 void
-AudioStream::alignWritePtr()
+AudioStream::endRead(i64 pos, isize copied, isize requested)
 {
-    {   SYNCHRONIZED
+    r.store(pos, std::memory_order_release);
+    consumed.fetch_add(copied, std::memory_order_relaxed);
 
-        align(cap() / 2);
-    }
+    // Inform the producer about a buffer underflow
+    if (copied < requested) starved.store(true, std::memory_order_release);
 }
 
 isize
 AudioStream::copyMono(float *buffer, isize n)
 {
-    {   SYNCHRONIZED
+    i64 end, pos = beginRead(end);
+    
+    // If a buffer underflow occurs ...
+    if (auto cnt = isize(end - pos); cnt < n) {
 
-        // If a buffer underflow occurs ...
-        if (auto cnt = count(); cnt < n) {
+        // ... copy all we have while stepwise lowering the volume ...
+        for (isize i = 0; i < cnt; i++) {
 
-            // ... copy all we have while stepwise lowering the volume ...
-            for (isize i = 0; i < cnt; i++) {
-
-                auto pair = read();
-                *buffer++ = (pair.l + pair.r) * float(cnt - i) / float(cnt);
-            }
-            assert(isEmpty());
-
-            // ... and fill the rest with zeroes.
-            for (isize i = cnt; i < n; i++) *buffer++ = 0;
-
-            return cnt;
+            auto pair = elements[pos++ % capacity];
+            *buffer++ = (pair.l + pair.r) * float(cnt - i) / float(cnt);
         }
 
-        // The standard case: The buffer contains enough samples
-        for (isize i = 0; i < n; i++) {
+        // ... and fill the rest with zeroes.
+        for (isize i = cnt; i < n; i++) *buffer++ = 0;
 
-            auto sample = read();
-            buffer[i] = 0.5f * (sample.l + sample.r);
-        }
+        endRead(pos, cnt, n);
+        return cnt;
+    }
 
-        return n;
+    // The standard case: The buffer contains enough samples
+    for (isize i = 0; i < n; i++) {
+
+        auto sample = elements[pos++ % capacity];
+        buffer[i] = 0.5f * (sample.l + sample.r);
     }
+
+    endRead(pos, n, n);
+    return n;
 }
 
 isize
 AudioStream::copyStereo(float *left, float *right, isize n)
 {
-    {   SYNCHRONIZED
-
-        // If a buffer underflow occurs ...
-        if (auto cnt = count(); cnt < n) {
-
-            // ... copy all we have while stepwise lowering the volume ...
-            for (isize i = 0; i < cnt; i++) {
+    i64 end, pos = beginRead(end);
 
-                auto pair = read();
-                *left++ = pair.l * float(cnt - i) / float(cnt);
-                *right++ = pair.r * float(cnt - i) / float(cnt);
-            }
-            assert(isEmpty());
+    // If a buffer underflow occurs ...
+    if (auto cnt = isize(end - pos); cnt < n) {
 
-            // ... and fill the rest with zeroes.
-            for (isize i = cnt; i < n; i++) *left++ = *right++ = 0;
+        // ... copy all we have while stepwise lowering the volume ...
+        for (isize i = 0; i < cnt; i++) {
 
-            return cnt;
+            auto pair = elements[pos++ % capacity];
+            *left++ = pair.l * float(cnt - i) / float(cnt);
+            *right++ = pair.r * float(cnt - i) / float(cnt);
         }
 
-        // The standard case: The buffer contains enough samples
-        for (isize i = 0; i < n; i++) {
+        // ... and fill the rest with zeroes.
+        for (isize i = cnt; i < n; i++) *left++ = *right++ = 0;
 
-            auto sample = read();
-            left[i] = sample.l;
-            right[i] = sample.r;
-        }
+        endRead(pos, cnt, n);
+        return cnt;
+    }
+
+    // The standard case: The buffer contains enough samples
+    for (isize i = 0; i < n; i++) {
 
-        return n;
+        auto sample = elements[pos++ % capacity];
+        left[i] = sample.l;
+        right[i] = sample.r;
     }
+
+    endRead(pos, n, n);
+    return n;
 }
 
 isize
 AudioStream::copyInterleaved(float *buffer, isize n)
 {
-    {   SYNCHRONIZED
-        
-        // If a buffer underflow occurs ...
-        if (auto cnt = count(); cnt < n) {
-            
-            // ... copy all we have while stepwise lowering the volume ...
-            for (isize i = 0; i < cnt; i++) {
-                
-                auto pair = read();
-                *buffer++ = pair.l * float(cnt - i) / float(cnt);
-                *buffer++ = pair.r * float(cnt - i) / float(cnt);
-            }
-            assert(isEmpty());
-            
-            // ... and fill the rest with zeroes.
-            for (isize i = cnt; i < n; i++) { *buffer++ = 0; *buffer++ = 0; }
-            
-            return cnt;
-        }
-        
-        // The standard case: The buffer contains enough samples
-        for (isize i = 0; i < n; i++) {
-            
-            auto sample = read();
-            *buffer++ = sample.l;
-            *buffer++ = sample.r;
+    i64 end, pos = beginRead(end);
+
+    // If a buffer underflow occurs ...
+    if (auto cnt = isize(end - pos); cnt < n) {
+
+        // ... copy all we have while stepwise lowering the volume ...
+        for (isize i = 0; i < cnt; i++) {
+
+            auto pair = elements[pos++ % capacity];
+            *buffer++ = pair.l * float(cnt - i) / float(cnt);
+            *buffer++ = pair.r * float(cnt - i) / float(cnt);
         }
-        
-        return n;
+
+        // ... and fill the rest with zeroes.
+        for (isize i = cnt; i < n; i++) { *buffer++ = 0; *buffer++ = 0; }
+
+        endRead(pos, cnt, n);
+        return cnt;
     }
+
+    // The standard case: The buffer contains enough samples
+    for (isize i = 0; i < n; i++) {
+
+        auto sample = elements[pos++ % capacity];
+        *buffer++ = sample.l;
+        *buffer++ = sample.r;
+    }
+
+    endRead(pos, n, n);
+    return n;
+}
+
+const SamplePair &
+AudioStream::current(isize offset) const
+{
+    return elements[(readPos() + offset) % capacity];
 }
 
 void
@@ -197,8 +272,6 @@ float
 AudioStream::draw(u32 *buffer, isize width, isize height, float highest,
                   std::function<float(float x)> data, u32 color) const
 {
-    SYNCHRONIZED
-
     float newHighestAmplitude = 0.001f;
 
     // Clear buffer
@@ -13,9 +13,8 @@
 #pragma once
 
 #include "CoreObject.h"
-#include "utl/abilities/Synchronizable.h"
-#include "utl/concurrency.h"
-#include "utl/storage/RingBuffer.h"
+#include <atomic>
+#include <functional>
 
 namespace vc64 {
 
@@ -24,6 +23,23 @@ namespace vc64 {
  * The audio stream is the last element in the audio pipeline. It is a temporary
  * storage for the final audio samples, waiting to be handed over to the audio
  * unit of the host machine.
+ *
+ * The stream is a wait-free single-producer, single-consumer ring buffer. The
+ * emulator thread is the only producer and the audio thread of the host the
+ * only consumer. Both sides own a monotonically increasing position counter,
+ * which lives in a cache line of its own. Neither side ever waits for the
+ * other one. Operations that would require to modify the other side's data
+ * are posted as requests instead:
+ *
+ *  - The producer asks the consumer to discard samples by setting skipTo
+ *    and to fade out the buffered samples by setting the fade flag.
+ *    Discarded samples count as consumed right away. Hence, the producer
+ *    can refill the freed slots before the consumer runs again. If the
+ *    consumer is copying at this time, it might pick up some of the new
+ *    samples in place of the discarded ones. This is a one-time glitch
+ *    in a situation where samples are lost anyway.
+ *  - The consumer informs the producer about a buffer underflow by setting
+ *    the starved flag. The producer then pads the buffer with silence.
  */
 
 struct SamplePair
@@ -40,32 +56,123 @@ struct SamplePair
 // AudioStream
 //
 
-class AudioStream : public CoreObject, public utl::Synchronizable, public utl::ResizableRingBuffer<SamplePair> {
+class AudioStream : public CoreObject {
 
 public:
 
+    // Number of buckets in the latency histogram
+    static constexpr isize latencyBuckets = 16;
+
+    // Width of a latency bucket in milliseconds
+    static constexpr isize latencyBucketWidth = 8;
+
+private:
+
+    // Size of a cache line (used to keep the two sides apart)
+    static constexpr isize cacheLine = 64;
+
+    // Element storage
+    SamplePair *elements = nullptr;
+
+    // Number of elements
+    isize capacity = 0;
+
+
+    //
+    // Producer side
+    //
+
+    // Number of samples written since power up
+    alignas(cacheLine) std::atomic<i64> w = 0;
+
+    // The consumer is asked to continue reading at this position
+    std::atomic<i64> skipTo = 0;
+
+    // The consumer is asked to fade out the buffered samples
+    std::atomic<bool> fade = false;
+
+    // Sample rate of the host audio unit (used to compute the latency)
+    std::atomic<double> sampleRate = 44100.0;
+
+
+    //
+    // Consumer side
+    //
+
+    // Number of samples read since power up
+    alignas(cacheLine) std::atomic<i64> r = 0;
+
+    // Indicates that the consumer has run out of samples
+    std::atomic<bool> starved = false;
+
+    // Number of samples that have been handed over to the audio unit
+    std::atomic<i64> consumed = 0;
+
+    // Latency histogram (sampled whenever the audio unit requests samples)
+    std::atomic<i64> latency[latencyBuckets] = { };
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    AudioStream(isize capacity);
+    ~AudioStream();
+
     const char *objectName() const override { return "AudioStream"; }
 
-    // Initializes the ring buffer with zeroes
+
+    //
+    // Querying the fill status
+    //
+
+public:
+
+    isize cap() const { return capacity; }
+    isize count() const;
+    isize free() const { return capacity - count(); }
+    double fillLevel() const { return (double)count() / double(capacity); }
+
+
+    //
+    // Producing samples (emulator thread)
+    //
+
+public:
+
+    // Appends a sample (the sample is dropped if the buffer is full)
+    void write(SamplePair pair);
+
+    // Appends the specified number of silent samples (as many as fit)
+    void pad(isize n);
+
+    // Asks the consumer to discard all buffered samples
     void wipeOut();
 
-    // Rescales the existing samples to gradually fade out
+    // Asks the consumer to discard the oldest samples until n samples remain
+    void trim(isize n);
+
+    // Asks the consumer to fade out the buffered samples (to avoid cracks)
     void eliminateCracks();
 
-    // Puts the write pointer somewhat ahead of the read pointer
+    // Pads the buffer with silence until it is filled about halfway
     void alignWritePtr();
 
+    // Checks and clears the underflow condition signaled by the consumer
+    bool underflowed() { return starved.exchange(false, std::memory_order_acquire); }
 
-    //
-    // Initializing
-    //
-    AudioStream(isize capacity) : utl::ResizableRingBuffer<SamplePair>(capacity) { }
+    // Informs the stream about the sample rate of the audio unit
+    void setSampleRate(double hz) { sampleRate.store(hz, std::memory_order_relaxed); }
 
 
     //
-    // Copying data
+    // Consuming samples (audio thread)
     //
 
+public:
+
     /* Copies n audio samples into a memory buffer. These functions mark the
      * final step in the audio pipeline. They are used to copy the generated
      * sound samples into the buffers of the native sound device. In additon
@@ -76,11 +183,40 @@ public:
     isize copyStereo(float *left, float *right, isize n);
     isize copyInterleaved(float *buffer, isize n);
 
+private:
+
+    // Processes pending requests and returns the current read position
+    i64 beginRead(i64 &end);
+
+    // Publishes the new read position
+    void endRead(i64 pos, isize copied, isize requested);
+
+    // Returns the read position as seen by the producer
+    i64 readPos() const;
+
+
+    //
+    // Analyzing
+    //
+
+public:
+
+    // Returns the number of samples handed over to the audio unit
+    i64 getConsumed() const { return consumed.load(std::memory_order_relaxed); }
+
+    // Returns the number of samples in a bucket of the latency histogram
+    i64 getLatency(isize bucket) const { return latency[bucket].load(std::memory_order_relaxed); }
+
+    // Returns a buffered sample (used for visualization only)
+    const SamplePair &current(isize offset) const;
+
 
     //
     // Visualizing the waveform
     //
 
+public:
+
     /* Plots a graphical representation of the waveform. Returns the highest
      * amplitute that was found in the ringbuffer. To implement auto-scaling,
      * pass the returned value as parameter highestAmplitude in the next call
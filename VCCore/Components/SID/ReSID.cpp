@@ -45,9 +45,7 @@ ReSID::_didReset(bool hard)
     sid = new reSID::SID();
     
     sid->set_chip_model((reSID::chip_model)model);
-    sid->set_sampling_parameters((double)clockFrequency,
-                                 (reSID::sampling_method)samplingMethod,
-                                 (double)sampleRate);
+    updateSamplingParameters();
     sid->enable_filter(emulateFilter);
 }
 
@@ -174,9 +172,7 @@ ReSID::setClockFrequency(u32 frequency)
     if (clockFrequency != frequency) {
 
         clockFrequency = frequency;
-        sid->set_sampling_parameters((double)clockFrequency,
-                                     (reSID::sampling_method)samplingMethod,
-                                     (double)sampleRate);
+        updateSamplingParameters();
         logdebug(SID_DEBUG, "Setting clock frequency to %d\n", frequency);
     }
 
@@ -211,9 +207,26 @@ ReSID::setSampleRate(double value)
     if (sampleRate != value) {
 
         sampleRate = value;
-        sid->set_sampling_parameters((double)clockFrequency,
-                                     (reSID::sampling_method)samplingMethod,
-                                     sampleRate);
+
+        bool resampling =
+        samplingMethod == SamplingMethod::RESAMPLE ||
+        samplingMethod == SamplingMethod::RESAMPLE_FASTMEM;
+
+        /* The sample rate is adjusted slightly in every frame by the ASR
+         * algorithm. Rebuilding the FIR tables each time is costly, and in
+         * RESAMPLE_FASTMEM mode it takes far longer than a frame. Hence, we
+         * keep the filter as long as the rate stays within 5% of the rate it
+         * has been designed for. This only shifts the filter's cutoff
+         * frequency by the same percentage.
+         */
+        if (resampling && std::abs(sampleRate - filterRate) < 0.05 * filterRate) {
+
+            sid->adjust_sampling_frequency(sampleRate);
+
+        } else {
+
+            updateSamplingParameters();
+        }
         logdebug(SID_DEBUG, "Setting sample rate to %f samples per second\n", sampleRate);
     }
 }
@@ -253,22 +266,28 @@ ReSID::setSamplingMethod(SamplingMethod value)
                 logdebug(SID_DEBUG, "Using sampling method SAMPLE_RESAMPLE.\n");
                 break;
             case SamplingMethod::RESAMPLE_FASTMEM:
-                logwarn("SAMPLE_RESAMPLE_FASTMEM not supported. Using SAMPLE_INTERPOLATE.\n");
-                value = SamplingMethod::INTERPOLATE;
+                logdebug(SID_DEBUG, "Using sampling method SAMPLE_RESAMPLE_FASTMEM.\n");
                 break;
             default:
                 logwarn("Unknown sampling method: %ld\n", (long)value);
         }
 
         samplingMethod = value;
-        sid->set_sampling_parameters((double)clockFrequency,
-                                     (reSID::sampling_method)samplingMethod,
-                                     (double)sampleRate);
+        updateSamplingParameters();
     }
 
     assert((SamplingMethod)sid->sampling == samplingMethod);
 }
 
+void
+ReSID::updateSamplingParameters()
+{
+    sid->set_sampling_parameters((double)clockFrequency,
+                                 (reSID::sampling_method)samplingMethod,
+                                 (double)sampleRate);
+    filterRate = sampleRate;
+}
+
 u8
 ReSID::peek(u16 addr)
 {	
@@ -312,4 +331,18 @@ ReSID::executeCycles(isize numCycles, SampleStream &stream)
     return samples;
 }
 
+isize
+ReSID::executeCycles(isize numCycles)
+{
+    if (numCycles > PAL::CYCLES_PER_SECOND) {
+        logwarn("Number of missing SID cycles is far too large\n");
+        numCycles = PAL::CYCLES_PER_SECOND;
+    }
+
+    // Advance the chip state without running the resampler
+    sid->clock((reSID::cycle_count)numCycles);
+
+    return 0;
+}
+
 }
@@ -24,6 +24,7 @@ namespace vc64 {
  *   List of modifications applied to reSID:
  *
  *     - Changed visibility of some objects from protected to public
+ *     - Replaced the FIR convolution loops by vectorized kernels
  *
  *   Good candidate for testing sound emulation:
  *
@@ -68,6 +69,9 @@ private:
     // Sample rate (usually set to 44.1 kHz or 48.0 kHz)
     double sampleRate = 0;
 
+    // Sample rate the resampling filter has been designed for
+    double filterRate = 0;
+
     // Sampling method
     SamplingMethod samplingMethod = SamplingMethod(0);
 
@@ -195,6 +199,11 @@ public:
     
     SamplingMethod getSamplingMethod() const;
     void setSamplingMethod(SamplingMethod value);
+
+private:
+
+    // Passes the sampling parameters to reSID (rebuilds the FIR tables)
+    void updateSamplingParameters();
     
     
     //
@@ -223,7 +232,8 @@ public:
     
     /* Runs SID for the specified amount of CPU cycles. The generated sound
      * samples are written into the provided ring buffer. The fuction returns
-     * the number of written audio samples.
+     * the number of written audio samples. The second variant only advances
+     * the chip state without producing any samples.
      */
     isize executeCycles(isize numCycles, SampleStream &stream);
     isize executeCycles(isize numCycles);
@@ -21,13 +21,28 @@ SID::SID(C64 &ref, isize id) : SubComponent(ref, id)
     setClockFrequency(PAL::CLOCK_FREQUENCY);
 }
 
+void
+SID::operator << (SerResetter &worker)
+{
+    c64.sidBridge.sync();
+    serialize(worker);
+}
+
 void
 SID::operator << (SerReader &worker)
 {
+    c64.sidBridge.sync();
     serialize(worker);
     stream.clear(0);
 }
 
+void
+SID::operator << (SerWriter &worker)
+{
+    c64.sidBridge.sync();
+    serialize(worker);
+}
+
 u8
 SID::spypeek(u16 addr) const
 {
@@ -60,13 +75,13 @@ SID::poke(u16 addr, u8 value)
     }
 }
 
-void 
-SID::executeUntil(Cycle targetCycle)
+void
+SID::execute(Cycle &cycle, Cycle targetCycle, bool skip)
 {
-    if (isEnabled() && !powerSave()) {
+    if (isEnabled() && !skip) {
 
         // Compute the number of missing cycles
-        Cycle missing = targetCycle - clock;
+        Cycle missing = targetCycle - cycle;
 
         // Check if SID is in sync with the CPU
         if (missing < -1000 || missing > 1000000) {
@@ -78,22 +93,82 @@ SID::executeUntil(Cycle targetCycle)
             // Make sure to run for at least one cycle to make pipelined writes worke
             if (missing < 1) missing = 1;
 
-            // Compute the missing samples
-            auto numSamples = resid.executeCycles(isize(missing), stream);
-            loginfo(SID_EXEC, "%ld: target: %lld missing: %lld generated: %ld", objid, targetCycle, missing, numSamples);
+            if (c64.isRunAheadInstance()) {
+
+                // The run-ahead instance is never heard. Skip the resampler
+                resid.executeCycles(isize(missing));
+
+            } else {
+
+                // Compute the missing samples
+                auto numSamples = resid.executeCycles(isize(missing), stream);
+                loginfo(SID_EXEC, "%ld: target: %lld missing: %lld generated: %ld", objid, targetCycle, missing, numSamples);
+            }
         }
     } else {
 
         // logdebug(STDERR, "Power safe mode\n");
     }
 
+    cycle = targetCycle;
+}
+
+void
+SID::logWrite(u16 addr, u8 value)
+{
+    sidreg[addr & 0x1F] = value;
+    writeLog.push_back({ cpu.clock, u8(addr & 0x1F), value });
+}
+
+void
+SID::replayLog()
+{
+    for (auto &w : writeLog) {
+
+        executeUntil(w.cycle);
+        poke(w.addr, w.value);
+    }
+    writeLog.clear();
+}
+
+void
+SID::prepareJob(Cycle targetCycle)
+{
+    assert(job.empty());
+
+    job.swap(writeLog);
+    jobStart = clock;
+    jobEnd = targetCycle;
+    jobPowerSave = powerSave();
+
+    // From the perspective of the C64 thread, the SID is up to date
     clock = targetCycle;
 }
 
+void
+SID::executeJob()
+{
+    for (auto &w : job) {
+
+        execute(jobStart, w.cycle, jobPowerSave);
+
+        // Don't touch the register mirror which belongs to the C64 thread
+        switch (config.engine) {
+
+            case SIDEngine::RESID:   resid.poke(w.addr, w.value); break;
+
+            default:
+                fatalError;
+        }
+    }
+    execute(jobStart, jobEnd, jobPowerSave);
+    job.clear();
+}
+
 bool
 SID::powerSave() const
 {
-    if (emulator.isWarping() && config.powerSave) {
+    if (emulator.isWarping() && (config.powerSave || c64.getConfig().maxSpeed)) {
 
         /* https://sourceforge.net/p/vice-emu/bugs/1374/
          *
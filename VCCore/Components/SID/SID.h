@@ -74,6 +74,22 @@ class SID final : public SubComponent, public Inspectable<SIDInfo>
     // The audio stream
     SampleStream stream;
 
+    // A timestamped register write
+    struct RegWrite { Cycle cycle; u8 addr; u8 value; };
+
+    // Register writes that haven't been passed to the backend yet
+    std::vector<RegWrite> writeLog;
+
+    // Register writes of a frame that is synthesized on the SID thread
+    std::vector<RegWrite> job;
+
+    // Start and end cycle of this frame
+    Cycle jobStart = 0;
+    Cycle jobEnd = 0;
+
+    // Indicates if sample synthesis is skipped in this frame
+    bool jobPowerSave = false;
+
 public:
 
     // Backends
@@ -128,11 +144,11 @@ public:
         << config.sampling;
     }
 
-    void operator << (SerResetter &worker) override { serialize(worker); }
+    void operator << (SerResetter &worker) override;
     void operator << (SerChecker &worker) override { serialize(worker); }
     void operator << (SerCounter &worker) override { serialize(worker); }
     void operator << (SerReader &worker) override;
-    void operator << (SerWriter &worker) override { serialize(worker); }
+    void operator << (SerWriter &worker) override;
 
 
     //
@@ -194,14 +210,40 @@ public:
     // Computing audio samples
     //
 
+public:
+
     /* Executes SID until a certain cycle is reached. The function returns the
      * number of produced sound samples (not yet).
      */
-    void executeUntil(Cycle targetCycle);
+    void executeUntil(Cycle targetCycle) { execute(clock, targetCycle, powerSave()); }
 
     // Indicates if sample synthesis should be skipped
     bool powerSave() const;
 
+private:
+
+    // Runs the backend from the specified cycle up to the target cycle
+    void execute(Cycle &cycle, Cycle targetCycle, bool skip);
+
+
+    //
+    // Logging register writes
+    //
+
+public:
+
+    // Records a register write instead of passing it to the backend
+    void logWrite(u16 addr, u8 value);
+
+    // Passes all recorded register writes to the backend
+    void replayLog();
+
+    // Turns the recorded register writes into a job for the SID thread
+    void prepareJob(Cycle targetCycle);
+
+    // Passes the register writes of a job to the backend (SID thread)
+    void executeJob();
+
     
     //
     // Bridge functions
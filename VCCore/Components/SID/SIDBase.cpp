@@ -159,6 +159,9 @@ SID::setOption(Opt opt, i64 value)
 {    
     checkOption(opt, value);
 
+    // Make sure the backend isn't busy on the SID thread
+    c64.sidBridge.sync();
+
     switch (opt) {
             
         case Opt::SID_ENABLE:
@@ -49,6 +49,7 @@ SIDBridge::peek(u16 addr)
     isize sidNr = mappedSID(addr);
 
     // Get the target SID up to date
+    sync();
     sid[sidNr].executeUntil(cpu.clock);
 
     addr &= 0x1F;
@@ -119,26 +120,47 @@ SIDBridge::poke(u16 addr, u8 value)
     // Select the target SID
     isize sidNr = mappedSID(addr);
 
-    // Get the target SID up to date
-    sid[sidNr].executeUntil(cpu.clock);
+    if (isThreaded()) {
+
+        // Record the write for the SID thread
+        sid[sidNr].logWrite(addr, value);
 
-    // Write the register
-    sid[sidNr].poke(addr, value);
+    } else {
+
+        // Get the target SID up to date
+        sync();
+        sid[sidNr].executeUntil(cpu.clock);
+
+        // Write the register
+        sid[sidNr].poke(addr, value);
+    }
 }
 
 void 
 SIDBridge::setClockFrequency(u32 frequency)
 {
-    for (isize i = 0; i < 4; i++) {
-        sid[i].setClockFrequency(frequency);
-    }
+    clockFrequency = frequency;
+
+    // Postpone the change if a prepared frame hasn't been synthesized yet
+    if (!busy) applyParameters();
 }
 
 void
 SIDBridge::setSampleRate(double rate)
+{
+    sampleRate = rate;
+
+    // Postpone the change if a prepared frame hasn't been synthesized yet
+    if (!busy) applyParameters();
+}
+
+void
+SIDBridge::applyParameters()
 {
     for (isize i = 0; i < 4; i++) {
-        sid[i].setSampleRate(rate);
+
+        sid[i].setClockFrequency(clockFrequency);
+        sid[i].setSampleRate(sampleRate);
     }
 }
 
@@ -153,19 +175,75 @@ SIDBridge::beginFrame()
 
     // Update the audio sample rate
     setSampleRate(audioPort.sampleRate + audioPort.sampleRateCorrection);
+
+    // Synthesize the previous frame in parallel
+    if (busy && !started) { started = true; thread.start(); }
 }
 
 void 
 SIDBridge::endFrame()
 {
-    // Execute all remaining SID cycles
-    sid0.executeUntil(cpu.clock);
-    sid1.executeUntil(cpu.clock);
-    sid2.executeUntil(cpu.clock);
-    sid3.executeUntil(cpu.clock);
+    if (isThreaded()) {
+
+        // Wait for the SID thread to finish the previous frame
+        finishJob();
+
+        // Hand the current frame over
+        for (isize i = 0; i < 4; i++) sid[i].prepareJob(cpu.clock);
+        busy = true;
+
+    } else {
+
+        // Execute all remaining SID cycles
+        sync();
+        sid0.executeUntil(cpu.clock);
+        sid1.executeUntil(cpu.clock);
+        sid2.executeUntil(cpu.clock);
+        sid3.executeUntil(cpu.clock);
+    }
+
+    // The run-ahead instance is never heard
+    if (c64.isRunAheadInstance()) return;
+
+    // Generate sound sampes (skipped in max-speed mode)
+    if (!c64.getConfig().maxSpeed) audioPort.generateSamples();
+}
+
+bool
+SIDBridge::isThreaded() const
+{
+    return c64.getConfig().sidThread && !c64.isRunAheadInstance();
+}
+
+void
+SIDBridge::sync()
+{
+    // Finish the previous frame
+    finishJob();
+
+    // Pass all register writes of the current frame to the backends
+    for (isize i = 0; i < 4; i++) {
+        if (!sid[i].writeLog.empty()) sid[i].replayLog();
+    }
+}
+
+void
+SIDBridge::executeJob()
+{
+    for (isize i = 0; i < 4; i++) sid[i].executeJob();
+}
+
+void
+SIDBridge::finishJob()
+{
+    if (!busy) return;
+
+    // Wait for the SID thread or synthesize the frame right here
+    if (started) thread.join(); else executeJob();
+    busy = started = false;
 
-    // Generate sound sampes
-    audioPort.generateSamples();
+    // Apply the sampling parameters that have been postponed
+    applyParameters();
 }
 
 float
@@ -18,6 +18,7 @@
 #include "AudioVolume.h"
 #include "AudioPort.h"
 #include "SID.h"
+#include "SIDThread.h"
 #include "utl/chrono.h"
 
 namespace vc64 {
@@ -42,6 +43,14 @@ namespace vc64 {
  *          |  |  SID3  |----->                               |
  *          |   --------                                      |
  *           -------------------------------------------------
+ *
+ * If the SID thread is enabled, SID register writes are not passed to the
+ * backends right away. They are timestamped and recorded in a per-SID log
+ * instead. At the end of a frame, the log is handed over to the SID thread,
+ * which synthesizes the frame while the C64 emulates the next one. The
+ * recorded samples are mixed one frame later. Reading a SID register is
+ * the only occasion where the C64 thread needs the backend up to date. In
+ * this case, it waits for the SID thread and replays the log on demand.
  */
 
 class SIDBridge final : public SubComponent {
@@ -76,6 +85,21 @@ public:
         SID(c64, 3)
     };
 
+private:
+
+    // Worker thread for synthesizing the audio output in parallel
+    SIDThread thread = SIDThread(*this);
+
+    // Indicates if a frame has been prepared that hasn't been synthesized yet
+    bool busy = false;
+
+    // Indicates if this frame has been passed to the SID thread
+    bool started = false;
+
+    // Sampling parameters of the frame in progress
+    u32 clockFrequency = PAL::CLOCK_FREQUENCY;
+    double sampleRate = 44100.0;
+
 
     //
     // Methods
@@ -133,6 +157,11 @@ public:
     // Adjusts the sample rate for all SIDs
     void setSampleRate(double rate);
 
+private:
+
+    // Passes the sampling parameters of the frame in progress to all SIDs
+    void applyParameters();
+
 
     //
     // Running the device
@@ -146,6 +175,27 @@ public:
     // Finishes the current frame
     void endFrame();
 
+
+    //
+    // Synthesizing in parallel
+    //
+
+public:
+
+    // Indicates if SID register writes are synthesized on the SID thread
+    bool isThreaded() const;
+
+    // Brings all backends up to date with the recorded register writes
+    void sync();
+
+    // Synthesizes a prepared frame (called by the SID thread)
+    void executeJob();
+
+private:
+
+    // Waits until the prepared frame has been synthesized
+    void finishJob();
+
     
     //
     // Accessig memory
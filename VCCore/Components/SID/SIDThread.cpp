@@ -0,0 +1,76 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#include "vcconfig.h"
+#include "SIDThread.h"
+#include "SIDBridge.h"
+
+namespace vc64 {
+
+SIDThread::~SIDThread()
+{
+    {   std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    cond.notify_all();
+
+    if (thread.joinable()) thread.join();
+}
+
+void
+SIDThread::start()
+{
+    {   std::lock_guard<std::mutex> lock(mutex);
+
+        // Launch the worker thread if it isn't running yet
+        if (!thread.joinable()) thread = std::thread(&SIDThread::main, this);
+
+        assert(!busy);
+        busy = true;
+    }
+    cond.notify_all();
+}
+
+void
+SIDThread::join()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this]() { return !busy; });
+}
+
+void
+SIDThread::main()
+{
+    loginfo(SID_DEBUG, "SID thread launched\n");
+
+    while (true) {
+
+        // Wait for the next frame
+        {   std::unique_lock<std::mutex> lock(mutex);
+
+            cond.wait(lock, [this]() { return quit || busy; });
+            if (quit) break;
+        }
+
+        // Synthesize the frame
+        bridge.executeJob();
+
+        {   std::lock_guard<std::mutex> lock(mutex);
+            busy = false;
+        }
+        cond.notify_all();
+    }
+
+    loginfo(SID_DEBUG, "SID thread terminated\n");
+}
+
+}
@@ -0,0 +1,79 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreObject.h"
+#include <condition_variable>
+#include <thread>
+
+namespace vc64 {
+
+class SIDBridge;
+
+/* The SID thread synthesizes the audio output of a frame while the C64 is
+ * already busy with emulating the next one. It is controlled by the SID
+ * bridge, which hands over a frame by calling start() and takes the SIDs
+ * back by calling join(). In between, the C64 thread does not touch the
+ * backends. The thread is launched lazily when the first frame is handed
+ * over.
+ */
+class SIDThread final : public CoreObject {
+
+    // Reference to the SID bridge
+    SIDBridge &bridge;
+
+    // The worker thread
+    std::thread thread;
+
+    // Synchronization primitives for handing over a frame
+    std::mutex mutex;
+    std::condition_variable cond;
+
+    // Indicates if the worker thread is synthesizing a frame
+    bool busy = false;
+
+    // Indicates if the worker thread should terminate
+    bool quit = false;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    SIDThread(SIDBridge &ref) : bridge(ref) { }
+    ~SIDThread();
+
+    const char *objectName() const override { return "SIDThread"; }
+
+
+    //
+    // Handing over frames
+    //
+
+public:
+
+    // Lets the worker thread synthesize the frame prepared by the SID bridge
+    void start();
+
+    // Waits until the worker thread has finished the current frame
+    void join();
+
+private:
+
+    // The main thread function
+    void main();
+};
+
+}
@@ -27,6 +27,19 @@
 #include "sid.h"
 #include <cmath>
 
+// DIRK: Vectorized FIR convolution
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RESID_SSE2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define RESID_AVX2
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RESID_NEON
+#endif
+
 #include <iostream>
 #include <fstream>
 using namespace std;
@@ -962,6 +975,124 @@ int SID::clock_interpolate(cycle_count& delta_t, short* buf, int n, int interlea
 // NB! the result of right shifting negative numbers is really
 // implementation dependent in the C++ standard.
 // ----------------------------------------------------------------------------
+// ----------------------------------------------------------------------------
+// DIRK: FIR convolution kernels.
+//
+// The inner product of the sample ring buffer and the FIR table dominates
+// the cost of resampling. Besides the scalar reference implementation, the
+// product is computed with SSE2, AVX2 or NEON instructions. The best kernel
+// is selected once at startup based on the features of the host CPU.
+//
+// All kernels multiply 16-bit values into exact 32-bit products and add them
+// up in 32-bit integer arithmetic. Since integer addition is associative
+// modulo 2^32, the vector kernels are bit-exact to the scalar code, no
+// matter in which order the products are summed up.
+// ----------------------------------------------------------------------------
+typedef int (*convolve_func)(const short* a, const short* b, int n);
+
+static int convolve_scalar(const short* a, const short* b, int n)
+{
+  int v = 0;
+  for (int j = 0; j < n; j++) {
+    v += a[j]*b[j];
+  }
+  return v;
+}
+
+#ifdef RESID_SSE2
+static int convolve_sse2(const short* a, const short* b, int n)
+{
+  __m128i acc = _mm_setzero_si128();
+  int j = 0;
+
+  for (; j + 8 <= n; j += 8) {
+    __m128i va = _mm_loadu_si128((const __m128i*)(a + j));
+    __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(va, vb));
+  }
+
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+  int v = _mm_cvtsi128_si32(acc);
+
+  for (; j < n; j++) {
+    v += a[j]*b[j];
+  }
+  return v;
+}
+#endif
+
+#ifdef RESID_AVX2
+__attribute__((target("avx2")))
+static int convolve_avx2(const short* a, const short* b, int n)
+{
+  __m256i acc = _mm256_setzero_si256();
+  int j = 0;
+
+  for (; j + 16 <= n; j += 16) {
+    __m256i va = _mm256_loadu_si256((const __m256i*)(a + j));
+    __m256i vb = _mm256_loadu_si256((const __m256i*)(b + j));
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(va, vb));
+  }
+
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc),
+                              _mm256_extracti128_si256(acc, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  int v = _mm_cvtsi128_si32(sum);
+
+  for (; j < n; j++) {
+    v += a[j]*b[j];
+  }
+  return v;
+}
+#endif
+
+#ifdef RESID_NEON
+static int convolve_neon(const short* a, const short* b, int n)
+{
+  int32x4_t acc = vdupq_n_s32(0);
+  int j = 0;
+
+  for (; j + 8 <= n; j += 8) {
+    int16x8_t va = vld1q_s16(a + j);
+    int16x8_t vb = vld1q_s16(b + j);
+    acc = vmlal_s16(acc, vget_low_s16(va), vget_low_s16(vb));
+    acc = vmlal_s16(acc, vget_high_s16(va), vget_high_s16(vb));
+  }
+
+#ifdef __aarch64__
+  int v = vaddvq_s32(acc);
+#else
+  int32x2_t sum = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+  int v = vget_lane_s32(vpadd_s32(sum, sum), 0);
+#endif
+
+  for (; j < n; j++) {
+    v += a[j]*b[j];
+  }
+  return v;
+}
+#endif
+
+static convolve_func select_convolve()
+{
+#ifdef RESID_AVX2
+  if (__builtin_cpu_supports("avx2")) {
+    return convolve_avx2;
+  }
+#endif
+#if defined(RESID_SSE2)
+  return convolve_sse2;
+#elif defined(RESID_NEON)
+  return convolve_neon;
+#else
+  return convolve_scalar;
+#endif
+}
+
+static const convolve_func convolve = select_convolve();
+
 int SID::clock_resample(cycle_count& delta_t, short* buf, int n, int interleave)
 {
   int s;
@@ -993,10 +1124,7 @@ int SID::clock_resample(cycle_count& delta_t, short* buf, int n, int interleave)
     short* sample_start = sample + sample_index - fir_N - 1 + RINGSIZE;
 
     // Convolution with filter impulse response.
-    int v1 = 0;
-    for (int j = 0; j < fir_N; j++) {
-      v1 += sample_start[j]*fir_start[j];
-    }
+    int v1 = convolve(sample_start, fir_start, fir_N);
 
     // Use next FIR table, wrap around to first FIR table using
     // next sample.
@@ -1007,10 +1135,7 @@ int SID::clock_resample(cycle_count& delta_t, short* buf, int n, int interleave)
     fir_start = fir + fir_offset*fir_N;
 
     // Convolution with filter impulse response.
-    int v2 = 0;
-    for (int k = 0; k < fir_N; k++) {
-      v2 += sample_start[k]*fir_start[k];
-    }
+    int v2 = convolve(sample_start, fir_start, fir_N);
 
     // Linear interpolation.
     // fir_offset_rmd is equal for all samples, it can thus be factorized out:
@@ -1059,10 +1184,7 @@ int SID::clock_resample_fastmem(cycle_count& delta_t, short* buf, int n, int int
     short* sample_start = sample + sample_index - fir_N + RINGSIZE;
 
     // Convolution with filter impulse response.
-    int v = 0;
-    for (int j = 0; j < fir_N; j++) {
-      v += sample_start[j]*fir_start[j];
-    }
+    int v = convolve(sample_start, fir_start, fir_N);
 
     v >>= FIR_SHIFT;
 
@@ -29,12 +29,10 @@ VICII::VICII(C64 &ref) : SubComponent(ref), dmaDebugger(ref)
 {    
     subComponents = std::vector<CoreComponent *> { &dmaDebugger };
 
-    initFuncTable(VICIIRev::PAL_6569_R1);
-    initFuncTable(VICIIRev::PAL_6569_R3);
-    initFuncTable(VICIIRev::PAL_8565);
-    initFuncTable(VICIIRev::NTSC_6567_R56A);
-    initFuncTable(VICIIRev::NTSC_6567);
-    initFuncTable(VICIIRev::NTSC_8562);
+    // Setup the texture pool
+    for (isize i = 0; i < NUM_TEXTURES; i++) ring[i] = i;
+    for (isize i = 0; i < NUM_PINS; i++) spares[i] = NUM_TEXTURES + i;
+    for (isize i = 0; i < NUM_PINS; i++) pins[i] = -1;
 
     // Assign reference clock to all time delayed variables
     baLine.setClock(&cpu.clock);
@@ -76,12 +74,21 @@ VICII::_didReset(bool hard)
         emuTexture = getWorkingBuffer().pixels.ptr;
         dmaTexture = getWorkingDmaBuffer().pixels.ptr;
     }
+
+    spriteCellsDirty = true;
+}
+
+void
+VICII::_didLoad()
+{
+    updateMemPtrs();
+    spriteCellsDirty = true;
 }
 
 void
 VICII::resetEmuTexture(isize nr)
 {
-    assert(nr < NUM_TEXTURES);
+    assert(nr < NUM_TEXTURES + NUM_PINS);
 
     emuTex[nr].clear(Texture::grey2, Texture::grey4);
 }
@@ -90,13 +97,13 @@ void
 VICII::resetEmuTextures()
 {
     // Wipe out all textures
-    for (isize i = 0; i < NUM_TEXTURES; i++) resetEmuTexture(i);
+    for (isize i = 0; i < NUM_TEXTURES + NUM_PINS; i++) resetEmuTexture(i);
 }
 
 void
 VICII::resetDmaTexture(isize nr)
 {
-    assert(nr < NUM_TEXTURES);
+    assert(nr < NUM_TEXTURES + NUM_PINS);
 
     dmaTex[nr].clear(Texture::black, Texture::black);
 }
@@ -107,7 +114,7 @@ VICII::resetDmaTextures()
     // resetDmaTexture(1); resetDmaTexture(2);
 
     // Wipe out all textures
-    for (isize i = 0; i < NUM_TEXTURES; i++) resetDmaTexture(i);
+    for (isize i = 0; i < NUM_TEXTURES + NUM_PINS; i++) resetDmaTexture(i);
 }
 
 void
@@ -183,7 +190,7 @@ VICII::setRevision(VICIIRev revision)
     isNTSC = !isPAL;
     is656x = !is856x;
 
-    vic.updateVicFunctionTable();
+    vic.updateKernel();
     c64.updateClockFrequency();
     
     msgQueue.put(isPAL ? Msg::PAL : Msg::NTSC);
@@ -275,25 +282,66 @@ VICII::isVBlankLine(isize line) const
 Texture &
 VICII::getWorkingBuffer()
 {
-    return emuTex[activeBuffer];
+    return emuTex[ring[activeBuffer]];
 }
 
 const Texture &
 VICII::getStableBuffer(isize offset) const
 {
-    return emuTex[(activeBuffer + offset - 1 + NUM_TEXTURES) % NUM_TEXTURES];
+    return emuTex[ring[(activeBuffer + offset - 1 + NUM_TEXTURES) % NUM_TEXTURES]];
 }
 
 Texture &
 VICII::getWorkingDmaBuffer()
 {
-    return dmaTex[activeBuffer];
+    return dmaTex[ring[activeBuffer]];
 }
 
 const Texture &
 VICII::getStableDmaBuffer(isize offset) const
 {
-    return dmaTex[(activeBuffer + offset - 1 + NUM_TEXTURES) % NUM_TEXTURES];
+    return dmaTex[ring[(activeBuffer + offset - 1 + NUM_TEXTURES) % NUM_TEXTURES]];
+}
+
+const Texture &
+VICII::acquireStableBuffer(isize consumer, isize offset) const
+{
+    assert(consumer >= 0 && consumer < TEX_CONSUMERS);
+    return emuTex[pinStableBuffer(emuPin(consumer), offset)];
+}
+
+const Texture &
+VICII::acquireStableDmaBuffer(isize consumer, isize offset) const
+{
+    assert(consumer >= 0 && consumer < TEX_CONSUMERS);
+    return dmaTex[pinStableBuffer(dmaPin(consumer), offset)];
+}
+
+isize
+VICII::pinStableBuffer(isize pin, isize offset) const
+{
+    while (true) {
+
+        // Wait until the emulator has finished switching buffers
+        auto seq = ringSeq.load();
+        if (seq & 1) continue;
+
+        // Pin the texture
+        auto nr = ring[(activeBuffer + offset - 1 + NUM_TEXTURES) % NUM_TEXTURES].load();
+        pins[pin] = nr;
+
+        /* If the ring buffer hasn't changed in the meantime, the emulator is
+         * guaranteed to see the pin the next time it switches buffers.
+         */
+        if (ringSeq.load() == seq) return nr;
+    }
+}
+
+bool
+VICII::isPinned(isize nr) const
+{
+    for (isize i = 0; i < NUM_PINS; i++) if (pins[i] == nr) return true;
+    return false;
 }
 
 void
@@ -676,9 +724,6 @@ VICII::updateSpriteShiftRegisters()
 void 
 VICII::beginFrame()
 {
-    // Setup cycle-specific callbacks
-    updateVicFunctionTable();
-
     /* "The VIC does five read accesses in every raster line for the refresh of
      *  the dynamic RAM. An 8 bit refresh counter (REF) is used to generate 256
      *  DRAM row addresses. The counter is reset to $ff in raster line 0 and
@@ -714,23 +759,39 @@ VICII::endFrame()
     if (debug) dmaDebugger.computeOverlay(emuTexture, dmaTexture);
 
     // Switch texture buffers
-    emulator.lockTexture();
-
     videoPort.buffersWillSwap();
-    
-    activeBuffer = (activeBuffer + 1) % NUM_TEXTURES;
-    emuTex[activeBuffer].nr = c64.frame;
-    dmaTex[activeBuffer].nr = c64.frame;
-    emuTexture = emuTex[activeBuffer].pixels.ptr;
-    dmaTexture = dmaTex[activeBuffer].pixels.ptr;
+
+    ringSeq++;
+
+    auto next = (activeBuffer + 1) % NUM_TEXTURES;
+
+    // Don't overwrite a texture that is held by a consumer
+    if (isPinned(ring[next])) {
+
+        for (isize i = 0; i < NUM_PINS; i++) {
+
+            if (!isPinned(spares[i])) {
+
+                spares[i] = ring[next].exchange(spares[i]);
+                break;
+            }
+        }
+    }
+
+    auto nr = ring[next].load();
+    activeBuffer = next;
+    emuTex[nr].nr = c64.frame;
+    dmaTex[nr].nr = c64.frame;
+    emuTexture = emuTex[nr].pixels.ptr;
+    dmaTexture = dmaTex[nr].pixels.ptr;
 
     if (debug) {
 
-        resetEmuTexture(activeBuffer);
-        resetDmaTexture(activeBuffer);
+        resetEmuTexture(nr);
+        resetDmaTexture(nr);
     }
 
-    emulator.unlockTexture();
+    ringSeq++;
 }
 
 void
@@ -751,6 +812,7 @@ VICII::processDelayedActions()
     }
     if (delay & VICUpdateRegisters) {
         reg.delayed = reg.current;
+        spriteCellsDirty = true;
     }
 
     // Less frequent actions
@@ -19,8 +19,10 @@
 #include "DmaDebugger.h"
 #include "MemoryTypes.h"
 #include "MonitorTypes.h"
+#include "VideoPortTypes.h"
 #include "TimeDelayed.h"
 #include "Texture.h"
+#include <atomic>
 
 namespace vc64 {
 
@@ -266,29 +268,20 @@ public:
     // Subcomponents
     DmaDebugger dmaDebugger;
 
-    /* The VICII function table. Each entry in this table is a pointer to a
-     * VICII method executed in a certain scanline cycle:
+    /* The currently selected scanline kernel. The kernel determines which
+     * instance of executeCycle() is called by the run loop. It is composed of
+     * the following cycle flags:
      *
-     *   functable[model][flags][cycle]
+     *     PAL_CYCLE       : Emulates PAL cycles, NTSC cycles otherwise
+     *     R56A_CYCLE      : Emulates 6567R56A cycles (PAL cycles in 1 .. 11)
+     *     DEBUG_CYCLE     : Runs the DMA debugger code
+     *     HEADLESS_CYCLE  : Skips all pixel-drawing related code
      *
-     *   model: VICII revision
-     *
-     *   flags: One or more of the following:
-     *
-     *     CYCLE_PAL       : Emulates a PAL cycle, NTSC otherwise
-     *     CYCLE_DMA       : Runs the DMA debugger code for the specific cycle
-     *     CYLCE_HEADLESS  : Skips all pixel-drawing related code
-     *
-     *   cycle: 1 .. 65 (cycle 0 is a stub and never called)
-     *
-     *   CYCLE_DMA and CYCLE_HEADLESS must be be set simultaneously as this
-     *   combination does not make sense.
+     * DEBUG_CYCLE and HEADLESS_CYCLE are never set simultaneously as this
+     * combination does not make sense. The kernel is selected at the beginning
+     * of each frame and stays the same until the frame is finished.
      */
-    typedef void (VICII::*ViciiFunc)(void);
-    ViciiFunc functable[6][8][66] = {};
-
-    // Function pointers currently in use
-    ViciiFunc vicfunc[66] = {};
+    u16 kernel = 0;
 
 
     //
@@ -622,6 +615,15 @@ private:
     
     // Collision bits
     u8 collision[8];
+
+    /* Sprite activity bitmap. For each 8 pixel wide range of X coordinates,
+     * this table records which sprites are triggered inside this range. It is
+     * derived from the sprite X coordinates and rebuilt lazily after they have
+     * changed. Together with spriteSrActive, it tells which cycles of a
+     * scanline can skip the sprite engine entirely.
+     */
+    u8 spriteCells[64];
+    bool spriteCellsDirty = true;
     
     
     //
@@ -667,6 +669,12 @@ private:
      * access to ROMH and some portions of RAM.
      */
     MemType memSrc[16];
+
+    /* Memory pointer table derived from memSrc. For each 4KB bank, it points
+     * to the RAM or ROM location serving this bank. A nullptr indicates that
+     * the bank is served by the expansion port.
+     */
+    const u8 *memPtr[16] = { };
     
     /* Indicates whether VICII is running in ultimax mode. Ultimax mode can be
      * enabled by external cartridges by pulling the game line low and keeping
@@ -733,6 +741,9 @@ private:
 
     static constexpr isize NUM_TEXTURES = 9;
 
+    // Number of textures that can be held by consumers at the same time
+    static constexpr isize NUM_PINS = 2 * TEX_CONSUMERS;
+
     // C64 colors in RGBA format (updated in updatePalette())
     u32 rgbaTable[16];
 
@@ -746,12 +757,36 @@ private:
      * drawn by the GUI. The dmaTex buffer contain the textures generated by
      * the DMA debugger. If DMA debugging is enabled, this texture is superimposed
      * on the emulator texture.
+     *
+     * To hand over frames without blocking the emulator thread, the ring
+     * buffer refers to the textures of a texture pool by index. Consumers pin
+     * the texture they are reading. If the emulator is about to overwrite a
+     * pinned texture, it swaps the texture with an unpinned spare texture from
+     * the pool. Hence, a pinned texture stays intact until it is released.
+     * Each consumer owns two pins (one for each texture kind), so consumers
+     * never release each other's textures.
      */
-    Texture emuTex[NUM_TEXTURES];
-    Texture dmaTex[NUM_TEXTURES];
+    Texture emuTex[NUM_TEXTURES + NUM_PINS];
+    Texture dmaTex[NUM_TEXTURES + NUM_PINS];
+
+    // Pool indices of the textures in the ring buffer
+    std::atomic<isize> ring[NUM_TEXTURES];
+
+    // Pool indices of the spare textures
+    isize spares[NUM_PINS];
 
-    // The currently active texture
-    isize activeBuffer = 0;
+    // The currently active texture (ring buffer position)
+    std::atomic<isize> activeBuffer = 0;
+
+    // Sequence number of the ring buffer (odd while it is modified)
+    std::atomic<i64> ringSeq = 0;
+
+    // Pool indices of the textures held by consumers (-1 if none)
+    mutable std::atomic<isize> pins[NUM_PINS];
+
+    // Returns the pin slot of a consumer
+    static isize emuPin(isize consumer) { return 2 * consumer; }
+    static isize dmaPin(isize consumer) { return 2 * consumer + 1; }
 
     /* Pointer to the current working texture. This variable points either to
      * the first or the second texture buffer. After a frame has been finished,
@@ -815,6 +850,8 @@ public:
 
         CLONE(dmaDebugger)
 
+        spriteCellsDirty = true;
+
         CLONE(reg)
         CLONE(rasterIrqLine)
         CLONE(latchedLPX)
@@ -883,7 +920,8 @@ public:
 
         CLONE(config)
 
-        updateVicFunctionTable();
+        updateMemPtrs();
+        updateKernel();
         return *this;
     }
 
@@ -999,6 +1037,7 @@ private:
     void _dump(Category category, std::ostream &os) const override;
     void _initialize() override;
     void _didReset(bool hard) override;
+    void _didLoad() override;
     void _trackOn() override;
     void _trackOff() override;
 
@@ -1050,14 +1089,13 @@ private:
     void resetDmaTextures();
     void resetTexture(u32 *p);
 
-    void initFuncTable(VICIIRev revision);
-    void initFuncTable(VICIIRev revision, u16 flags);
-    ViciiFunc getViciiFunc(u16 flags, isize cycle);
-    template <u16 flags> ViciiFunc getViciiFunc(isize cycle);
-
 public:
 
-    void updateVicFunctionTable();
+    // Selects the scanline kernel for the next frame
+    void updateKernel();
+
+    // Returns the currently selected scanline kernel
+    u16 getKernel() const { return kernel; }
 
 
     //
@@ -1136,6 +1174,24 @@ private:
     Texture &getWorkingDmaBuffer();
     const Texture &getStableDmaBuffer(isize offset = 0) const;
 
+    /* Returns a stable buffer and pins it. This function is called by
+     * consumers outside of the emulator thread. It never blocks. The returned
+     * texture remains unchanged until it is released or another texture is
+     * acquired.
+     */
+    const Texture &acquireStableBuffer(isize consumer, isize offset = 0) const;
+    const Texture &acquireStableDmaBuffer(isize consumer, isize offset = 0) const;
+
+    // Releases a pinned texture
+    void releaseStableBuffer(isize consumer) const { pins[emuPin(consumer)] = -1; }
+    void releaseStableDmaBuffer(isize consumer) const { pins[dmaPin(consumer)] = -1; }
+
+    // Pins a stable texture and returns its pool index
+    isize pinStableBuffer(isize pin, isize offset) const;
+
+    // Checks if a texture is held by a consumer
+    bool isPinned(isize nr) const;
+
 
     //
     // Accessing memory (VIC_memory.cpp)
@@ -1151,6 +1207,9 @@ public:
 
     // Sets the ultimax flag
     void setUltimax(bool value);
+
+    // Derives the memory pointer table from the memory source table
+    void updateMemPtrs();
     
     // Returns the latest value of the VICII's data bus during phi1
     u8 getDataBusPhi1() const { return dataBusPhi1; }
@@ -1466,6 +1525,13 @@ public:
      */
     void processDelayedActions();
     
+public:
+
+    // Emulates a scanline cycle with the specified kernel
+    template <u16 flags> void executeCycle(isize cycle);
+
+private:
+
     // Emulates a specific scanline cycle
     template <u16 flags> void cycle1();
     template <u16 flags> void cycle2();
@@ -1551,6 +1617,11 @@ private:
     void drawCanvasFastPath();
     void drawCanvasSlowPath();
 
+    /* Draws 8 canvas pixels at once if the shift register has been loaded at
+     * the first pixel. Returns false if this is not possible.
+     */
+    bool drawCanvasCell();
+
     // Draws a single canvas pixel
     void drawCanvasPixel(u8 pixel, u8 mode, u8 d016);
     
@@ -1584,6 +1655,12 @@ private:
 
     // Performs collision detection
     void checkCollisions();
+
+    // Rebuilds the sprite activity bitmap
+    void updateSpriteCells();
+
+    // Checks if a sprite needs to be processed in the current cycle
+    bool spritesInCurrentCycle();
     
     
     //
@@ -174,6 +174,7 @@ VICII::clearStats()
         double canvasTotal = stats.canvasFastPath + stats.canvasSlowPath;
         double spriteTotal = stats.spriteFastPath + stats.spriteSlowPath;
         double exitTotal = stats.quickExitHit + stats.quickExitMiss;
+        double earlyTotal = stats.spriteEarlyOut + stats.spriteFastPath;
 
         loginfo(STDERR, "Canvas: Fast path: %ld Slow path: %ld Ratio: %f\n",
             stats.canvasFastPath,
@@ -190,6 +191,10 @@ VICII::clearStats()
             stats.quickExitMiss,
             exitTotal != 0 ? stats.quickExitHit / exitTotal : -1);
 
+        loginfo(STDERR, "Sprites: Early out: %ld Ratio: %f\n",
+            stats.spriteEarlyOut,
+            earlyTotal != 0 ? stats.spriteEarlyOut / earlyTotal : -1);
+
         memset(&stats, 0, sizeof(stats));
     }
 }
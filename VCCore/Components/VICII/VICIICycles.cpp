@@ -1092,47 +1092,71 @@ void VICII::sFinalize(isize sprite)
 }
 
 
+//
+// Dispatching cycles
+//
+
+template <u16 flags> void
+VICII::executeCycle(isize cycle)
+{
+    assert(cycle >= 1 && cycle <= 65);
+
+    /* The 6567R56A behaves like a PAL chip in cycles 1 to 11 and like an NTSC
+     * chip in all other cycles.
+     */
+    constexpr u16 late = flags & ~R56A_CYCLE;
+    constexpr u16 early = (flags & R56A_CYCLE) ? (late | PAL_CYCLE) : late;
+
+    switch (cycle) {
+
+        case 1: cycle1 <early> (); break;
+        case 2: cycle2 <early> (); break;
+        case 3: cycle3 <early> (); break;
+        case 4: cycle4 <early> (); break;
+        case 5: cycle5 <early> (); break;
+        case 6: cycle6 <early> (); break;
+        case 7: cycle7 <early> (); break;
+        case 8: cycle8 <early> (); break;
+        case 9: cycle9 <early> (); break;
+        case 10: cycle10 <early> (); break;
+        case 11: cycle11 <early> (); break;
+        case 12: cycle12 <late> (); break;
+        case 13: cycle13 <late> (); break;
+        case 14: cycle14 <late> (); break;
+        case 15: cycle15 <late> (); break;
+        case 16: cycle16 <late> (); break;
+        case 17: cycle17 <late> (); break;
+        case 18: cycle18 <late> (); break;
+
+        case 55: cycle55 <late> (); break;
+        case 56: cycle56 <late> (); break;
+        case 57: cycle57 <late> (); break;
+        case 58: cycle58 <late> (); break;
+        case 59: cycle59 <late> (); break;
+        case 60: cycle60 <late> (); break;
+        case 61: cycle61 <late> (); break;
+        case 62: cycle62 <late> (); break;
+        case 63: cycle63 <late> (); break;
+        case 64: cycle64 <late> (); break;
+        case 65: cycle65 <late> (); break;
+
+        default: cycle19to54 <late> (); break;
+    }
+}
+
+
 //
 // Instantiate template functions
 //
 
-#define VICIIFUNCS(args) \
-template void VICII::cycle1<args>(); \
-template void VICII::cycle2<args>(); \
-template void VICII::cycle3<args>(); \
-template void VICII::cycle4<args>(); \
-template void VICII::cycle5<args>(); \
-template void VICII::cycle6<args>(); \
-template void VICII::cycle7<args>(); \
-template void VICII::cycle8<args>(); \
-template void VICII::cycle9<args>(); \
-template void VICII::cycle10<args>(); \
-template void VICII::cycle11<args>(); \
-template void VICII::cycle12<args>(); \
-template void VICII::cycle13<args>(); \
-template void VICII::cycle14<args>(); \
-template void VICII::cycle15<args>(); \
-template void VICII::cycle16<args>(); \
-template void VICII::cycle17<args>(); \
-template void VICII::cycle18<args>(); \
-template void VICII::cycle19to54<args>(); \
-template void VICII::cycle55<args>(); \
-template void VICII::cycle56<args>(); \
-template void VICII::cycle57<args>(); \
-template void VICII::cycle58<args>(); \
-template void VICII::cycle59<args>(); \
-template void VICII::cycle60<args>(); \
-template void VICII::cycle61<args>(); \
-template void VICII::cycle62<args>(); \
-template void VICII::cycle63<args>(); \
-template void VICII::cycle64<args>(); \
-template void VICII::cycle65<args>();
-
-VICIIFUNCS(0)
-VICIIFUNCS(DEBUG_CYCLE)
-VICIIFUNCS(HEADLESS_CYCLE)
-VICIIFUNCS(PAL_CYCLE)
-VICIIFUNCS(PAL_CYCLE | DEBUG_CYCLE)
-VICIIFUNCS(PAL_CYCLE | HEADLESS_CYCLE)
+template void VICII::executeCycle<0>(isize);
+template void VICII::executeCycle<DEBUG_CYCLE>(isize);
+template void VICII::executeCycle<HEADLESS_CYCLE>(isize);
+template void VICII::executeCycle<PAL_CYCLE>(isize);
+template void VICII::executeCycle<PAL_CYCLE | DEBUG_CYCLE>(isize);
+template void VICII::executeCycle<PAL_CYCLE | HEADLESS_CYCLE>(isize);
+template void VICII::executeCycle<R56A_CYCLE>(isize);
+template void VICII::executeCycle<R56A_CYCLE | DEBUG_CYCLE>(isize);
+template void VICII::executeCycle<R56A_CYCLE | HEADLESS_CYCLE>(isize);
 
 }
@@ -13,19 +13,130 @@
 #include "vcconfig.h"
 #include "VICII.h"
 #include "C64.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define VICII_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define VICII_NEON
+#endif
 
 namespace vc64 {
 
+//
+// Vectorized drawing primitives
+//
+
+// Writes eight texels of the same color
+static inline void
+fill8(u32 *tex, u32 rgba)
+{
+#if defined(VICII_SSE2)
+
+    auto v = _mm_set1_epi32(int(rgba));
+    _mm_storeu_si128((__m128i *)tex, v);
+    _mm_storeu_si128((__m128i *)(tex + 4), v);
+
+#elif defined(VICII_NEON)
+
+    auto v = vdupq_n_u32(rgba);
+    vst1q_u32(tex, v);
+    vst1q_u32(tex + 4, v);
+
+#else
+
+    for (isize i = 0; i < 8; i++) tex[i] = rgba;
+
+#endif
+}
+
+/* Writes eight texels and the corresponding z-buffer entries. The color of
+ * each texel is selected out of four colors by the corresponding bits of the
+ * two masks (bit 7 refers to the leftmost texel). Texels with the hi bit set
+ * are drawn in the foreground layer, all others in the background layer.
+ */
+static inline void
+blend8(u32 *tex, u8 *z, u8 hi, u8 lo, const u32 *col)
+{
+#if defined(VICII_SSE2)
+
+    auto expand = [](u8 mask, __m128i bits) {
+        return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(mask), bits), bits);
+    };
+    auto select = [](__m128i mask, __m128i a, __m128i b) {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    };
+
+    auto c0 = _mm_set1_epi32(int(col[0]));
+    auto c1 = _mm_set1_epi32(int(col[1]));
+    auto c2 = _mm_set1_epi32(int(col[2]));
+    auto c3 = _mm_set1_epi32(int(col[3]));
+
+    for (isize i = 0; i < 2; i++) {
+
+        auto bits = i == 0 ? _mm_setr_epi32(0x80, 0x40, 0x20, 0x10) : _mm_setr_epi32(0x08, 0x04, 0x02, 0x01);
+        auto h = expand(hi, bits);
+        auto l = expand(lo, bits);
+        _mm_storeu_si128((__m128i *)(tex + 4 * i), select(h, select(l, c3, c2), select(l, c1, c0)));
+    }
+
+    auto bits = _mm_setr_epi8(i8(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0, 0, 0, 0, 0, 0, 0, 0);
+    auto h = _mm_cmpeq_epi8(_mm_and_si128(_mm_set1_epi8(i8(hi)), bits), bits);
+    auto depth = select(h, _mm_set1_epi8(i8(DEPTH_FG)), _mm_set1_epi8(i8(DEPTH_BG)));
+    _mm_storel_epi64((__m128i *)z, depth);
+
+#elif defined(VICII_NEON)
+
+    static const u32 bitsL[4] = { 0x80, 0x40, 0x20, 0x10 };
+    static const u32 bitsR[4] = { 0x08, 0x04, 0x02, 0x01 };
+    static const u8 bits8[8] = { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 };
+
+    auto c0 = vdupq_n_u32(col[0]);
+    auto c1 = vdupq_n_u32(col[1]);
+    auto c2 = vdupq_n_u32(col[2]);
+    auto c3 = vdupq_n_u32(col[3]);
+
+    for (isize i = 0; i < 2; i++) {
+
+        auto bits = vld1q_u32(i == 0 ? bitsL : bitsR);
+        auto h = vtstq_u32(vdupq_n_u32(hi), bits);
+        auto l = vtstq_u32(vdupq_n_u32(lo), bits);
+        vst1q_u32(tex + 4 * i, vbslq_u32(h, vbslq_u32(l, c3, c2), vbslq_u32(l, c1, c0)));
+    }
+
+    auto h = vtst_u8(vdup_n_u8(hi), vld1_u8(bits8));
+    vst1_u8(z, vbsl_u8(h, vdup_n_u8(DEPTH_FG), vdup_n_u8(DEPTH_BG)));
+
+#else
+
+    for (isize i = 0; i < 8; i++) {
+
+        auto h = (hi >> (7 - i)) & 1;
+        auto l = (lo >> (7 - i)) & 1;
+        tex[i] = col[h << 1 | l];
+        z[i] = h ? DEPTH_FG : DEPTH_BG;
+    }
+
+#endif
+}
+
+
+//
+// Drawing the border
+//
+
 void
 VICII::drawBorder()
 {
     if (flipflops.delayed.main) {
-        
-        SET_FRAME_PIXEL(0, reg.delayed.colors[VICIIColorReg::BORDER]);
-        
-        for (isize pixel = 1; pixel <= 7; pixel++) {
-            SET_FRAME_PIXEL(pixel, reg.current.colors[VICIIColorReg::BORDER]);
-        }
+
+        isize index = bufferoffset;
+
+        fill8(emuTexturePtr + index, rgbaTable[reg.current.colors[VICIIColorReg::BORDER]]);
+        emuTexturePtr[index] = rgbaTable[reg.delayed.colors[VICIIColorReg::BORDER]];
+        std::memset(zBuffer + index, DEPTH_BORDER, 8);
     }
 }
 
@@ -61,6 +172,11 @@ VICII::drawBorder55()
     }
 }
 
+
+//
+// Drawing the canvas
+//
+
 void
 VICII::drawCanvas()
 {
@@ -77,6 +193,13 @@ VICII::drawCanvasFastPath()
     if (debug::VICII_STATS) stats.canvasFastPath++;
     
     u8 xscroll = reg.delayed.xscroll;
+
+    // If the shift register is loaded at the first pixel, draw all at once
+    if (xscroll == 0) {
+
+        loadShiftRegister();
+        if (drawCanvasCell()) return;
+    }
     
     switch (reg.delayed.mode) {
             
@@ -196,6 +319,83 @@ VICII::drawCanvasFastPath()
     }
 }
 
+bool
+VICII::drawCanvasCell()
+{
+    u32 col[4];
+    bool multicolor = false;
+
+    switch (reg.delayed.mode) {
+
+        case DisplayMode::MULTICOLOR_TEXT:
+
+            if (sr.latchedCol & 0x8) {
+
+                col[0] = rgbaTable[reg.delayed.colors[VICIIColorReg::BG_0]];
+                col[1] = rgbaTable[reg.delayed.colors[VICIIColorReg::BG_1]];
+                col[2] = rgbaTable[reg.delayed.colors[VICIIColorReg::BG_2]];
+                col[3] = rgbaTable[sr.latchedCol & 0x07];
+                multicolor = true;
+                break;
+            }
+            [[fallthrough]];
+
+        case DisplayMode::STANDARD_TEXT:
+
+            col[0] = col[1] = rgbaTable[reg.delayed.colors[VICIIColorReg::BG_0]];
+            col[2] = col[3] = rgbaTable[sr.latchedCol];
+            break;
+
+        case DisplayMode::STANDARD_BITMAP:
+
+            col[0] = col[1] = rgbaTable[LO_NIBBLE(sr.latchedChr)];
+            col[2] = col[3] = rgbaTable[HI_NIBBLE(sr.latchedChr)];
+            break;
+
+        case DisplayMode::MULTICOLOR_BITMAP:
+
+            col[0] = rgbaTable[reg.delayed.colors[VICIIColorReg::BG_0]];
+            col[1] = rgbaTable[HI_NIBBLE(sr.latchedChr)];
+            col[2] = rgbaTable[LO_NIBBLE(sr.latchedChr)];
+            col[3] = rgbaTable[sr.latchedCol];
+            multicolor = true;
+            break;
+
+        case DisplayMode::EXTENDED_BG_COLOR:
+
+            col[0] = col[1] = rgbaTable[reg.delayed.colors[VICIIColorReg::BG_0 + (sr.latchedChr >> 6)]];
+            col[2] = col[3] = rgbaTable[sr.latchedCol];
+            break;
+
+        default:
+            return false;
+    }
+
+    u8 data = sr.data;
+    isize index = bufferoffset;
+
+    if (multicolor) {
+
+        // Multicolor pixels are only aligned if the flipflop is set
+        if (!sr.mcFlop) return false;
+
+        // Duplicate each bit of a bit pair
+        u8 hi = (data & 0xAA) | ((data & 0xAA) >> 1);
+        u8 lo = (data & 0x55) | ((data & 0x55) << 1);
+        blend8(emuTexturePtr + index, zBuffer + index, hi, lo, col);
+        sr.colorbits = data & 0x3;
+
+    } else {
+
+        blend8(emuTexturePtr + index, zBuffer + index, data, data, col);
+        sr.colorbits = data & 0x1;
+    }
+
+    // Leave the shift register in the same state as the scalar code does
+    sr.data = 0;
+    return true;
+}
+
 void
 VICII::drawCanvasSlowPath()
 {
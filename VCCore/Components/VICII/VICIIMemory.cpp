@@ -61,6 +61,33 @@ VICII::setUltimax(bool value) {
         memSrc[0xE] = MemType::RAM;
         memSrc[0xF] = MemType::RAM;
     }
+
+    updateMemPtrs();
+}
+
+void
+VICII::updateMemPtrs()
+{
+    for (isize bank = 0; bank < 16; bank++) {
+
+        switch (memSrc[bank]) {
+
+            case MemType::CHAR:
+
+                // The character ROM is mirrored into banks $1 and $9
+                memPtr[bank] = mem.rom + 0xD000;
+                break;
+
+            case MemType::CRTHI:
+
+                memPtr[bank] = nullptr;
+                break;
+
+            default:
+
+                memPtr[bank] = mem.ram + (bank << 12);
+        }
+    }
 }
 
 void
@@ -622,20 +649,11 @@ VICII::memAccess(u16 addr)
     assert((bankAddr & 0x3FFF) == 0); // multiple of 16 KB
     
     addrBus = bankAddr | addr;
-    switch (memSrc[addrBus >> 12]) {
-            
-        case MemType::RAM:
-            return mem.ram[addrBus];
-            
-        case MemType::CHAR:
-            return mem.rom[0xC000 + addr];
 
-        case MemType::CRTHI:
-            return expansionPort.peek(addrBus | 0xF000);
-            
-        default:
-            return mem.ram[addrBus];
-    }
+    // RAM and the character ROM are accessed via the pointer table
+    if (auto p = memPtr[addrBus >> 12]) return p[addrBus & 0xFFF];
+
+    return expansionPort.peek(addrBus | 0xF000);
 }
 
 u8
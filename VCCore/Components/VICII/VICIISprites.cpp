@@ -12,6 +12,7 @@
 
 #include "vcconfig.h"
 #include "VICII.h"
+#include <cstring>
 
 namespace vc64 {
 
@@ -23,11 +24,43 @@ VICII::drawSprites()
     
     if ((delay & VICUpdateRegisters) || debug::VICII_SAFE_MODE == 1) {
         drawSpritesSlowPath();
-    } else {
+    } else if (spritesInCurrentCycle()) {
         drawSpritesFastPath();
+    } else {
+        if (debug::VICII_STATS) stats.spriteEarlyOut++;
     }
 }
 
+void
+VICII::updateSpriteCells()
+{
+    std::memset(spriteCells, 0, sizeof(spriteCells));
+
+    for (isize i = 0; i < 8; i++) {
+        spriteCells[(reg.delayed.sprX[i] >> 3) & 63] |= u8(1 << i);
+    }
+    spriteCellsDirty = false;
+}
+
+bool
+VICII::spritesInCurrentCycle()
+{
+    // Active shift registers are processed in every cycle
+    if (spriteSrActive) return true;
+
+    if (spriteCellsDirty) updateSpriteCells();
+
+    /* Check if a displayed sprite is triggered in one of the eight pixels
+     * drawn in this cycle. If the X counter is not aligned, the pixels are
+     * spread over two ranges.
+     */
+    u8 triggered =
+    spriteCells[(xCounter >> 3) & 63] |
+    spriteCells[((xCounter + 7) >> 3) & 63];
+
+    return triggered & spriteDisplay;
+}
+
 //
 // Fast path
 //
@@ -36,6 +36,7 @@ namespace vc64 {
 static const u16 PAL_CYCLE      = 0b0001;
 static const u16 DEBUG_CYCLE    = 0b0010;
 static const u16 HEADLESS_CYCLE = 0b0100;
+static const u16 R56A_CYCLE     = 0b1000;
 
 /* Depths of different drawing layers
  *
@@ -351,6 +352,7 @@ typedef struct
     isize spriteSlowPath;
     isize quickExitHit;
     isize quickExitMiss;
+    isize spriteEarlyOut;
 }
 VICIIStats;
 
@@ -13,9 +13,12 @@
 
 #include "vcconfig.h"
 #include "Headless.h"
+#include "BatchRunner.h"
 #include "C64.h"
 #include "Script.h"
 #include <chrono>
+#include <iomanip>
+#include <thread>
 
 int main(int argc, char *argv[])
 {
@@ -25,15 +28,27 @@ int main(int argc, char *argv[])
 
     } catch (vc64::SyntaxError &e) {
 
-        std::cout << "Usage: VirtualC64Headless [-fsdvm] [<script>]" << std::endl;
+        std::cout << "Usage: VirtualC64Headless [-fsdvm] [-p <benchmark>] [-c <check>] [<script>]" << std::endl;
+        std::cout << "       VirtualC64Headless -b [-vwB] [-j <n>] [-t <sec>] [-o <dir>] [-g <snapshot>] <files>" << std::endl;
         std::cout << std::endl;
         std::cout << "       -f or --footprint   Report the size of objects" << std::endl;
         std::cout << "       -s or --smoke       Run smoke tests to test the build" << std::endl;
         std::cout << "       -d or --diagnose    Launch the emulator thread" << std::endl;
         std::cout << "       -v or --verbose     Print the executed script lines" << std::endl;
         std::cout << "       -m or --messages    Observe the message queue" << std::endl;
+        std::cout << "       -p or --perf        Run a micro benchmark (vicii, guards, blocks, drives, runahead, trace, memory)" << std::endl;
+        std::cout << "       -c or --check       Run a consistency check (vdrive, audio, textures, blocks, drive, dthread, cia)" << std::endl;
         std::cout << "       <script>            Execute a custom script" << std::endl;
         std::cout << std::endl;
+        std::cout << "       -b or --batch       Run scripts or media files on multiple instances" << std::endl;
+        std::cout << "       -j or --jobs        Number of emulator instances" << std::endl;
+        std::cout << "       -t or --timeout     Maximum emulated time per job in seconds" << std::endl;
+        std::cout << "       -o or --output      Directory for storing textures" << std::endl;
+        std::cout << "       -w or --warm        Start all jobs from a pre-booted state" << std::endl;
+        std::cout << "       -g or --golden      Start all jobs from the given snapshot" << std::endl;
+        std::cout << "       -B or --benchmark   Compare the throughput of cold and warm starts" << std::endl;
+        std::cout << "       @<file>             Read file names from a list file" << std::endl;
+        std::cout << std::endl;
 
         if (auto what = std::string(e.what()); !what.empty()) {
             std::cout << what << std::endl;
@@ -75,6 +90,9 @@ Headless::main(int argc, char *argv[])
     if (keys.find("footprint") != keys.end())   { reportSize(); }
     if (keys.find("smoke") != keys.end())       { runScript(smokeTestScript); }
     if (keys.find("diagnose") != keys.end())    { runScript(selfTestScript); }
+    if (keys.find("perf") != keys.end())        { runBenchmark(keys["perf"]); }
+    if (keys.find("check") != keys.end())       { runCheck(keys["check"]); }
+    if (keys.find("batch") != keys.end())       { runBatch(); return returnCode; }
     if (keys.find("arg1") != keys.end())        { runScript(keys["arg1"]); }
 
     return returnCode;
@@ -87,7 +105,16 @@ Headless::parseArguments(int argc, char *argv[])
     keys["exec"] = std::filesystem::absolute(std::filesystem::path(argv[0])).string();
 
     // Parse command line arguments
-    for (isize i = 1, n = 1; i < argc; i++) {
+    isize i = 1, n = 1;
+
+    // Reads the value of an option that requires an argument
+    auto value = [&](const string &arg) {
+
+        if (++i == argc) throw SyntaxError("Missing value for option '" + arg + "'");
+        return string(argv[i]);
+    };
+
+    for (; i < argc; i++) {
 
         auto arg = string(argv[i]);
 
@@ -98,10 +125,38 @@ Headless::parseArguments(int argc, char *argv[])
             if (arg == "-d" || arg == "--diagnose")  { keys["diagnose"] = "1"; continue; }
             if (arg == "-v" || arg == "--verbose")   { keys["verbose"] = "1"; continue; }
             if (arg == "-m" || arg == "--messages")  { keys["messages"] = "1"; continue; }
+            if (arg == "-b" || arg == "--batch")     { keys["batch"] = "1"; continue; }
+            if (arg == "-w" || arg == "--warm")      { keys["warm"] = "1"; continue; }
+            if (arg == "-B" || arg == "--benchmark") { keys["benchmark"] = "1"; continue; }
+
+            if (arg == "-j" || arg == "--jobs")      { keys["jobs"] = value(arg); continue; }
+            if (arg == "-t" || arg == "--timeout")   { keys["timeout"] = value(arg); continue; }
+            if (arg == "-o" || arg == "--output")    { keys["output"] = value(arg); continue; }
+            if (arg == "-g" || arg == "--golden")    { keys["golden"] = value(arg); continue; }
+            if (arg == "-p" || arg == "--perf")      { keys["perf"] = value(arg); continue; }
+            if (arg == "-c" || arg == "--check")     { keys["check"] = value(arg); continue; }
 
             throw SyntaxError("Invalid option '" + arg + "'");
         }
 
+        // Expand list files
+        if (arg[0] == '@') {
+
+            auto list = std::ifstream(arg.substr(1));
+            if (!list.is_open()) throw SyntaxError("Cannot open list file " + arg.substr(1));
+
+            auto base = std::filesystem::absolute(std::filesystem::path(arg.substr(1))).parent_path();
+            for (string line; std::getline(list, line); ) {
+
+                line = utl::trim(line, " \t\r");
+                if (line.empty() || line[0] == '#') continue;
+
+                auto path = std::filesystem::path(line);
+                keys["arg" + std::to_string(n++)] = (path.is_absolute() ? path : base / path).string();
+            }
+            continue;
+        }
+
         auto path = std::filesystem::path(arg);
         keys["arg" + std::to_string(n++)] = std::filesystem::absolute(path).string();
     }
@@ -113,6 +168,57 @@ Headless::parseArguments(int argc, char *argv[])
 void
 Headless::checkArguments()
 {
+    // The benchmark must exist
+    if (keys.contains("perf")) {
+
+        auto &perf = keys["perf"];
+        if (perf != "vicii" && perf != "guards" && perf != "blocks" && perf != "drives" &&
+            perf != "runahead" && perf != "trace" && perf != "memory") {
+            throw SyntaxError("Unknown benchmark '" + perf + "'");
+        }
+    }
+
+    // The consistency check must exist
+    if (keys.contains("check")) {
+
+        auto &check = keys["check"];
+        if (check != "vdrive" && check != "audio" && check != "textures" &&
+            check != "blocks" && check != "drive" && check != "dthread" && check != "cia") {
+            throw SyntaxError("Unknown check '" + check + "'");
+        }
+    }
+
+    if (keys.contains("batch")) {
+
+        // At least one file must be specified
+        if (!keys.contains("arg1")) throw SyntaxError("No input files are given");
+
+        // All input files must exist
+        for (isize i = 1; keys.contains("arg" + std::to_string(i)); i++) {
+
+            auto &file = keys["arg" + std::to_string(i)];
+            if (!utl::fileExists(file)) throw SyntaxError("File " + file + " does not exist");
+        }
+
+        // The golden snapshot must exist
+        if (keys.contains("golden") && !utl::fileExists(keys["golden"])) {
+            throw SyntaxError("File " + keys["golden"] + " does not exist");
+        }
+
+        // Numeric arguments must be valid
+        try {
+
+            if (keys.contains("jobs") && std::stol(keys["jobs"]) < 1) throw std::invalid_argument("");
+            if (keys.contains("timeout") && std::stod(keys["timeout"]) <= 0) throw std::invalid_argument("");
+
+        } catch (std::exception &) {
+
+            throw SyntaxError("Invalid numeric argument");
+        }
+
+        return;
+    }
+
     // At most one file must be specified
     if (keys.find("arg2") != keys.end()) {
         throw SyntaxError("More than one script file is given");
@@ -127,10 +233,12 @@ Headless::checkArguments()
 
     } else {
 
-        // Either -f, -s, or -d needs to be specified
+        // Either -f, -s, -d, -p, or -c needs to be specified
         if (!keys.contains("footprint") &&
             !keys.contains("smoke") &&
-            !keys.contains("diagnose")) throw SyntaxError("");
+            !keys.contains("diagnose") &&
+            !keys.contains("perf") &&
+            !keys.contains("check")) throw SyntaxError("");
     }
 }
 
@@ -173,6 +281,1063 @@ Headless::runScript(const fs::path &path)
     waitForWakeUp(timeout);
 }
 
+void
+Headless::runBatch()
+{
+    std::vector<fs::path> files;
+    for (isize i = 1; keys.contains("arg" + std::to_string(i)); i++) {
+        files.push_back(keys["arg" + std::to_string(i)]);
+    }
+
+    BatchRunner::Config config;
+
+    config.instances = keys.contains("jobs") ?
+    isize(std::stol(keys["jobs"])) : isize(std::max(1U, std::thread::hardware_concurrency()));
+    config.timeout = keys.contains("timeout") ? std::stod(keys["timeout"]) : 60.0;
+    config.outputDir = fs::absolute(keys.contains("output") ? keys["output"] : "/tmp");
+    config.warmStart = keys.contains("warm");
+    config.snapshot = keys.contains("golden") ? fs::absolute(keys["golden"]) : fs::path();
+    config.verbose = keys.contains("verbose");
+
+    // Create the output directory if it doesn't exist yet
+    fs::create_directories(config.outputDir);
+
+    if (keys.contains("benchmark")) {
+
+        // Run all jobs with a cold start
+        auto coldConfig = config;
+        coldConfig.warmStart = false;
+        coldConfig.snapshot.clear();
+        BatchRunner cold(files, coldConfig);
+        cold.run();
+
+        // Run all jobs with a warm start
+        auto warmConfig = config;
+        warmConfig.warmStart = true;
+        BatchRunner warm(files, warmConfig);
+        auto failed = warm.run();
+        warm.summary(std::cout);
+
+        auto speedup = cold.jobsPerSecond() > 0 ? warm.jobsPerSecond() / cold.jobsPerSecond() : 0.0;
+
+        std::cout << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "Cold start: " << cold.jobsPerSecond() << " jobs/sec" << std::endl;
+        std::cout << "Warm start: " << warm.jobsPerSecond() << " jobs/sec" << std::endl;
+        std::cout << "  Speed-up: " << speedup << "x" << std::endl;
+
+        if (failed) returnCode = 1;
+        return;
+    }
+
+    // Run all jobs
+    BatchRunner runner(files, config);
+    auto failed = runner.run();
+    runner.summary(std::cout);
+
+    if (failed) returnCode = 1;
+}
+
+void
+Headless::runBenchmark(const string &name)
+{
+    if (name == "vicii") benchmarkVICII();
+    if (name == "guards") benchmarkGuards();
+    if (name == "blocks") benchmarkBlocks();
+    if (name == "drives") benchmarkDrives();
+    if (name == "runahead") benchmarkRunAhead();
+    if (name == "trace") benchmarkTracer();
+    if (name == "memory") benchmarkMemory();
+}
+
+void
+Headless::benchmarkVICII()
+{
+    // Number of emulated frames per measurement
+    const isize frames = 1000;
+
+    VirtualC64 emu;
+
+    emu.c64.installOpenRoms();
+    emu.c64.deleteRom(RomType::VC1541);
+    emu.set(Opt::DRV_CONNECT, false, 0);
+    emu.set(Opt::DRV_CONNECT, false, 1);
+
+    // Launch the emulator thread (the instance is never powered on)
+    emu.launch();
+
+    std::cout << std::left << std::setw(18) << "VICII revision";
+    std::cout << std::right << std::setw(14) << "Frames/sec";
+    std::cout << std::setw(14) << "Headless" << std::endl << std::endl;
+
+    for (auto rev : { VICIIRev::PAL_6569_R1, VICIIRev::PAL_6569_R3, VICIIRev::PAL_8565,
+                      VICIIRev::NTSC_6567_R56A, VICIIRev::NTSC_6567, VICIIRev::NTSC_8562 }) {
+
+        double fps[2];
+
+        emu.set(Opt::VICII_REVISION, i64(rev));
+
+        for (isize headless = 0; headless < 2; headless++) {
+
+            // The headless kernel is selected in max-speed mode
+            emu.set(Opt::C64_MAX_SPEED, headless);
+
+            {   emu.suspend();
+
+                auto &c64 = *emu.c64.c64;
+
+                // Boot the C64
+                c64.hardReset();
+                c64.fastForward(isize(3 * c64.refreshRate()));
+
+                // Measure
+                utl::Clock clock;
+                c64.fastForward(frames);
+                fps[headless] = double(frames) / clock.getElapsedTime().asSeconds();
+
+                emu.resume();
+            }
+        }
+
+        std::cout << std::left << std::setw(18) << VICIIRevEnum::key(rev);
+        std::cout << std::right << std::fixed << std::setprecision(1);
+        std::cout << std::setw(14) << fps[0] << std::setw(14) << fps[1] << std::endl;
+    }
+
+    emu.set(Opt::C64_MAX_SPEED, false);
+}
+
+void
+Headless::benchmarkGuards()
+{
+    // Number of emulated frames per measurement
+    const isize frames = 1000;
+
+    VirtualC64 emu;
+
+    emu.c64.installOpenRoms();
+    emu.c64.deleteRom(RomType::VC1541);
+    emu.set(Opt::DRV_CONNECT, false, 0);
+    emu.set(Opt::DRV_CONNECT, false, 1);
+    emu.set(Opt::C64_MAX_SPEED, true);
+
+    // Launch the emulator thread (the instance is never powered on)
+    emu.launch();
+
+    std::cout << std::left << std::setw(18) << "Guards";
+    std::cout << std::right << std::setw(14) << "Frames/sec" << std::endl << std::endl;
+
+    for (isize count : { 0, 10, 100, 1000 }) {
+
+        double fps;
+
+        {   emu.suspend();
+
+            auto &c64 = *emu.c64.c64;
+
+            // Boot the C64
+            c64.hardReset();
+            c64.fastForward(isize(3 * c64.refreshRate()));
+
+            /* Set up breakpoints and watchpoints in unused RAM. They never
+             * trigger, because their skip count is never reached.
+             */
+            for (isize i = 0; i < count; i++) {
+
+                c64.cpu.setBreakpoint(u32(0xC000 + i), INT32_MAX);
+                c64.cpu.setWatchpoint(u32(0xC000 + i), INT32_MAX);
+            }
+
+            // Measure
+            utl::Clock clock;
+            c64.fastForward(frames);
+            fps = double(frames) / clock.getElapsedTime().asSeconds();
+
+            c64.cpu.deleteAllBreakpoints();
+            c64.cpu.deleteAllWatchpoints();
+
+            emu.resume();
+        }
+
+        std::cout << std::left << std::setw(18) << count;
+        std::cout << std::right << std::fixed << std::setprecision(1);
+        std::cout << std::setw(14) << fps << std::endl;
+    }
+
+    emu.set(Opt::C64_MAX_SPEED, false);
+}
+
+void
+Headless::benchmarkBlocks()
+{
+    // Number of emulated frames per measurement
+    const isize frames = 1000;
+
+    VirtualC64 emu;
+
+    emu.c64.installOpenRoms();
+    emu.c64.deleteRom(RomType::VC1541);
+    emu.set(Opt::DRV_CONNECT, false, 0);
+    emu.set(Opt::DRV_CONNECT, false, 1);
+
+    // Launch the emulator thread (the instance is never powered on)
+    emu.launch();
+
+    std::cout << std::left << std::setw(18) << "Block execution";
+    std::cout << std::right << std::setw(14) << "Frames/sec";
+    std::cout << std::setw(14) << "Headless" << std::endl << std::endl;
+
+    for (isize blocks = 0; blocks < 2; blocks++) {
+
+        double fps[2];
+
+        emu.set(Opt::C64_BLOCK_EXEC, blocks);
+
+        for (isize headless = 0; headless < 2; headless++) {
+
+            // The headless kernel is selected in max-speed mode
+            emu.set(Opt::C64_MAX_SPEED, headless);
+
+            {   emu.suspend();
+
+                auto &c64 = *emu.c64.c64;
+
+                // Boot the C64
+                c64.hardReset();
+                c64.fastForward(isize(3 * c64.refreshRate()));
+
+                // Measure
+                utl::Clock clock;
+                c64.fastForward(frames);
+                fps[headless] = double(frames) / clock.getElapsedTime().asSeconds();
+
+                emu.resume();
+            }
+        }
+
+        std::cout << std::left << std::setw(18) << (blocks ? "on" : "off");
+        std::cout << std::right << std::fixed << std::setprecision(1);
+        std::cout << std::setw(14) << fps[0] << std::setw(14) << fps[1] << std::endl;
+    }
+
+    emu.set(Opt::C64_MAX_SPEED, false);
+}
+
+void
+Headless::benchmarkDrives()
+{
+    // Number of emulated frames per measurement
+    const isize frames = 500;
+
+    std::cout << std::left << std::setw(18) << "Drive thread";
+    std::cout << std::right << std::setw(14) << "One drive";
+    std::cout << std::setw(14) << "Two drives" << std::endl << std::endl;
+
+    for (isize threaded = 0; threaded < 2; threaded++) {
+
+        double fps[2];
+
+        for (isize count = 1; count <= 2; count++) {
+
+            VirtualC64 emu;
+
+            emu.c64.installOpenRoms();
+            emu.set(Opt::C64_DRIVE_THREAD, threaded);
+            launchTestDrives(emu, count);
+
+            {   emu.suspend();
+
+                auto &c64 = *emu.c64.c64;
+
+                // Boot the C64 and spin up the drives
+                c64.hardReset();
+                c64.fastForward(isize(3 * c64.refreshRate()));
+
+                // Measure
+                utl::Clock clock;
+                c64.fastForward(frames);
+                fps[count - 1] = double(frames) / clock.getElapsedTime().asSeconds();
+
+                emu.resume();
+            }
+
+            emu.powerOff();
+        }
+
+        std::cout << std::left << std::setw(18) << (threaded ? "on" : "off");
+        std::cout << std::right << std::fixed << std::setprecision(1);
+        std::cout << std::setw(14) << fps[0] << std::setw(14) << fps[1] << std::endl;
+    }
+}
+
+void
+Headless::benchmarkRunAhead()
+{
+    // Number of emulated frames per measurement
+    const isize frames = 500;
+
+    VirtualC64 emu;
+
+    /* The run-ahead instance created below owns no textures. Hence, both
+     * instances compute their frames with the headless kernel.
+     */
+    emu.set(Opt::C64_MAX_SPEED, true);
+
+    // Let the run-ahead instance hold two drives with a disk each
+    emu.c64.installOpenRoms();
+    launchTestDrives(emu, 2);
+
+    std::cout << std::left << std::setw(18) << "Update";
+    std::cout << std::right << std::setw(14) << "Frames/sec";
+    std::cout << std::setw(14) << "Usec/update" << std::endl << std::endl;
+
+    for (isize incremental = 0; incremental < 2; incremental++) {
+
+        double fps, usec;
+
+        {   emu.suspend();
+
+            auto &c64 = *emu.c64.c64;
+
+            // Boot the C64 and spin up the drives
+            c64.hardReset();
+            c64.fastForward(isize(3 * c64.refreshRate()));
+
+            // Create a run-ahead instance the same way the emulator does
+            auto ahead = std::make_unique<C64>(*emu.emu, 1);
+            ahead->msgQueue.disable();
+            ahead->resetConfig();
+            *ahead = c64;
+
+            /* Measure the worst case where the run-ahead instance is updated
+             * in every frame, e.g., while the joystick is moved. The instance
+             * runs one frame ahead of the main instance.
+             */
+            utl::Clock clock, update;
+            update.stop();
+
+            for (isize i = 0; i < frames; i++) {
+
+                c64.fastForward(1);
+
+                update.go();
+                if (incremental) ahead->syncWith(c64); else *ahead = c64;
+                update.stop();
+
+                ahead->fastForward(1);
+            }
+
+            fps = double(frames) / clock.getElapsedTime().asSeconds();
+            usec = update.getElapsedTime().asSeconds() * 1000000.0 / double(frames);
+
+            emu.resume();
+        }
+
+        std::cout << std::left << std::setw(18) << (incremental ? "Incremental" : "Full clone");
+        std::cout << std::right << std::fixed << std::setprecision(1);
+        std::cout << std::setw(14) << fps << std::setw(14) << usec << std::endl;
+    }
+
+    emu.powerOff();
+    emu.set(Opt::C64_MAX_SPEED, false);
+}
+
+void
+Headless::benchmarkTracer()
+{
+    // Number of emulated frames per measurement
+    const isize frames = 1000;
+
+    auto path = std::filesystem::temp_directory_path() / "vc64bench.trace";
+
+    VirtualC64 emu;
+
+    emu.c64.installOpenRoms();
+    emu.c64.deleteRom(RomType::VC1541);
+    emu.set(Opt::DRV_CONNECT, false, 0);
+    emu.set(Opt::DRV_CONNECT, false, 1);
+
+    // Launch the emulator thread (the instance is never powered on)
+    emu.launch();
+
+    std::cout << std::left << std::setw(18) << "Tracer";
+    std::cout << std::right << std::setw(14) << "Frames/sec";
+    std::cout << std::setw(14) << "Headless" << std::endl << std::endl;
+
+    double fps[2][2];
+
+    for (isize tracing = 0; tracing < 2; tracing++) {
+
+        for (isize headless = 0; headless < 2; headless++) {
+
+            // The headless kernel is selected in max-speed mode
+            emu.set(Opt::C64_MAX_SPEED, headless);
+
+            {   emu.suspend();
+
+                auto &c64 = *emu.c64.c64;
+
+                // Boot the C64
+                c64.hardReset();
+                c64.fastForward(isize(3 * c64.refreshRate()));
+
+                // Measure
+                if (tracing) c64.tracer.start(path);
+                utl::Clock clock;
+                c64.fastForward(frames);
+                fps[tracing][headless] = double(frames) / clock.getElapsedTime().asSeconds();
+                if (tracing) c64.tracer.stop();
+
+                emu.resume();
+            }
+        }
+
+        std::cout << std::left << std::setw(18) << (tracing ? "on" : "off");
+        std::cout << std::right << std::fixed << std::setprecision(1);
+        std::cout << std::setw(14) << fps[tracing][0] << std::setw(14) << fps[tracing][1] << std::endl;
+    }
+
+    std::cout << std::left << std::setw(18) << "Slowdown";
+    std::cout << std::right << std::fixed << std::setprecision(2);
+    std::cout << std::setw(13) << fps[0][0] / fps[1][0] << "x";
+    std::cout << std::setw(13) << fps[0][1] / fps[1][1] << "x" << std::endl;
+
+    std::filesystem::remove(path);
+    emu.set(Opt::C64_MAX_SPEED, false);
+}
+
+void
+Headless::benchmarkMemory()
+{
+    // A BASIC program reading and writing RAM, ROM, and I/O space
+    const char *program =
+    "10 fori=0to255:pokei+49152,peek(i+40960)andpeek(i+53248):next:goto10\n"
+    "run\n";
+
+    // Number of emulated frames per measurement
+    const isize frames = 1000;
+
+    VirtualC64 emu;
+
+    emu.c64.installOpenRoms();
+    emu.c64.deleteRom(RomType::VC1541);
+    emu.set(Opt::DRV_CONNECT, false, 0);
+    emu.set(Opt::DRV_CONNECT, false, 1);
+
+    // Launch the emulator thread (the instance is never powered on)
+    emu.launch();
+
+    std::cout << std::left << std::setw(18) << "Workload";
+    std::cout << std::right << std::setw(14) << "Frames/sec";
+    std::cout << std::setw(14) << "Headless" << std::endl << std::endl;
+
+    for (isize basic = 0; basic < 2; basic++) {
+
+        double fps[2];
+
+        for (isize headless = 0; headless < 2; headless++) {
+
+            // The headless kernel is selected in max-speed mode
+            emu.set(Opt::C64_MAX_SPEED, headless);
+
+            {   emu.suspend();
+
+                auto &c64 = *emu.c64.c64;
+
+                // Boot the C64 and start the BASIC program if requested
+                c64.hardReset();
+                c64.fastForward(isize(3 * c64.refreshRate()));
+                if (basic) c64.keyboard.autoType(program);
+                c64.fastForward(isize(2 * c64.refreshRate()));
+
+                // Measure
+                utl::Clock clock;
+                c64.fastForward(frames);
+                fps[headless] = double(frames) / clock.getElapsedTime().asSeconds();
+
+                emu.resume();
+            }
+        }
+
+        std::cout << std::left << std::setw(18) << (basic ? "BASIC loop" : "Idle");
+        std::cout << std::right << std::fixed << std::setprecision(1);
+        std::cout << std::setw(14) << fps[0] << std::setw(14) << fps[1] << std::endl;
+    }
+
+    emu.set(Opt::C64_MAX_SPEED, false);
+}
+
+void
+Headless::runCheck(const string &name)
+{
+    if (name == "vdrive") checkVirtualDrive();
+    if (name == "audio") checkAudioStream();
+    if (name == "textures") checkTextures();
+    if (name == "blocks") checkBlockExecution();
+    if (name == "drive") checkDriveRead();
+    if (name == "dthread") checkDriveThread();
+    if (name == "cia") checkCIASleep();
+}
+
+void
+Headless::report(const string &check, bool success)
+{
+    std::cout << std::left << std::setw(40) << check << (success ? "passed" : "FAILED") << std::endl;
+    if (!success) returnCode = 1;
+}
+
+void
+Headless::launchTestDrives(VirtualC64 &emu, isize count)
+{
+    /* A minimal drive firmware that reads the disk forever. It waits for
+     * BYTE READY (V flag), stores the data byte and port B of VIA2 (SYNC),
+     * and echoes the serial bus inputs to the outputs. After each page, it
+     * steps the head and switches the speed zone. The stepping direction is
+     * reversed every 64 steps.
+     */
+    static const u8 code[] = {
+
+        0x78,                   //         SEI
+        0xD8,                   //         CLD
+        0xA2, 0xFF,             //         LDX #$FF
+        0x9A,                   //         TXS
+        0xA9, 0x1A,             //         LDA #$1A
+        0x8D, 0x02, 0x18,       //         STA $1802   ; VIA1 DDRB
+        0xA9, 0x6F,             //         LDA #$6F
+        0x8D, 0x02, 0x1C,       //         STA $1C02   ; VIA2 DDRB
+        0xA9, 0x00,             //         LDA #$00
+        0x8D, 0x03, 0x1C,       //         STA $1C03   ; VIA2 DDRA
+        0xA9, 0xEE,             //         LDA #$EE
+        0x8D, 0x0C, 0x1C,       //         STA $1C0C   ; Read mode, SOE on
+        0xA9, 0x41,             //         LDA #$41
+        0x8D, 0x0B, 0x1C,       //         STA $1C0B   ; Latch port A
+        0xA9, 0x6C,             //         LDA #$6C
+        0x8D, 0x00, 0x1C,       //         STA $1C00   ; Motor and LED on
+        0xA2, 0x00,             //         LDX #$00
+        0x50, 0xFE,             // loop:   BVC loop
+        0xB8,                   //         CLV
+        0xAD, 0x01, 0x1C,       //         LDA $1C01
+        0x9D, 0x00, 0x03,       //         STA $0300,X
+        0xAD, 0x00, 0x1C,       //         LDA $1C00
+        0x9D, 0x00, 0x04,       //         STA $0400,X
+        0xAD, 0x00, 0x18,       //         LDA $1800
+        0x29, 0x05,             //         AND #$05
+        0x0A,                   //         ASL
+        0x8D, 0x00, 0x18,       //         STA $1800
+        0xE8,                   //         INX
+        0xD0, 0xE5,             //         BNE loop
+        0xE6, 0x10,             //         INC $10
+        0xA5, 0x10,             //         LDA $10
+        0x29, 0x40,             //         AND #$40
+        0xF0, 0x04,             //         BEQ in
+        0xA9, 0xFF,             //         LDA #$FF
+        0xD0, 0x02,             //         BNE step
+        0xA9, 0x01,             // in:     LDA #$01
+        0x18,                   // step:   CLC
+        0x6D, 0x00, 0x1C,       //         ADC $1C00
+        0x29, 0x03,             //         AND #$03
+        0x85, 0x11,             //         STA $11
+        0xA5, 0x10,             //         LDA $10
+        0x0A,                   //         ASL
+        0x0A,                   //         ASL
+        0x29, 0x60,             //         AND #$60
+        0x09, 0x0C,             //         ORA #$0C
+        0x05, 0x11,             //         ORA $11
+        0x8D, 0x00, 0x1C,       //         STA $1C00
+        0x4C, 0x25, 0xC0        //         JMP loop
+    };
+
+    // Create a 16KB Rom with the code at $C000 and all vectors pointing to it
+    std::vector<u8> rom(0x4000);
+    std::copy(std::begin(code), std::end(code), rom.begin());
+    for (isize i = 0x3FFA; i < 0x4000; i += 2) { rom[i] = 0x00; rom[i + 1] = 0xC0; }
+
+    auto &c64 = *emu.c64.c64;
+    c64.drive8.mem.loadRom(rom.data(), isize(rom.size()));
+    c64.drive9.mem.loadRom(rom.data(), isize(rom.size()));
+
+    emu.set(Opt::DRV_CONNECT, count > 0, 0);
+    emu.set(Opt::DRV_CONNECT, count > 1, 1);
+
+    // The stepping head floods the message queue while fast-forwarding
+    c64.msgQueue.disable();
+
+    // Drives are only emulated if the emulator is powered on
+    emu.launch();
+    emu.powerOn();
+
+    // Wait until the emulator thread has processed the power-on command
+    for (isize i = 0; i < 100 && !emu.isPoweredOn(); i++) utl::Time::milliseconds(10).sleep();
+
+    {   emu.suspend();
+
+        // Insert a formatted disk into each connected drive
+        if (count > 0) c64.drive8.insertNewDisk(FSFormat::CBM, "TEST DISK");
+        if (count > 1) c64.drive9.insertNewDisk(FSFormat::CBM, "TEST DISK");
+
+        // Wait until the disk change procedure has finished
+        auto inserted = [&]() {
+            return c64.drive8.hasDisk() == (count > 0) && c64.drive9.hasDisk() == (count > 1);
+        };
+        for (isize i = 0; i < 100 && !inserted(); i++) c64.fastForward(1);
+
+        emu.resume();
+    }
+}
+
+void
+Headless::checkVirtualDrive()
+{
+    // Create a directory with a single file spanning multiple pages
+    auto dir = std::filesystem::temp_directory_path() / "vc64check";
+    std::filesystem::create_directories(dir);
+
+    std::vector<u8> prg = { 0x00, 0xC0 };
+    for (isize i = 0; i < 0x1000; i++) prg.push_back(u8(i * 7 + (i >> 8)));
+    std::ofstream(dir / "check.prg", std::ios::binary).write((const char *)prg.data(), prg.size());
+
+    VirtualC64 emu;
+
+    emu.c64.installOpenRoms();
+    emu.c64.deleteRom(RomType::VC1541);
+    emu.set(Opt::DRV_CONNECT, false, 0);
+    emu.set(Opt::DRV_CONNECT, false, 1);
+    emu.set(Opt::VDR_ENABLE, true);
+    emu.set(Opt::C64_MAX_SPEED, true);
+
+    // Launch the emulator thread (the instance is never powered on)
+    emu.launch();
+
+    {   emu.suspend();
+
+        auto &c64 = *emu.c64.c64;
+        c64.vdrive.attach(8, dir);
+
+        // Boot the C64
+        c64.hardReset();
+        c64.fastForward(isize(3 * c64.refreshRate()));
+
+        /* Create a run-ahead instance the same way the emulator does. The
+         * instance is fully cloned once and synchronized incrementally
+         * afterwards, i.e., only the RAM pages marked dirty are copied.
+         */
+        auto ahead = std::make_unique<C64>(*emu.emu, 1);
+        ahead->msgQueue.disable();
+        ahead->resetConfig();
+        *ahead = c64;
+        ahead->syncWith(c64);
+        report("Full clone matches", *ahead == c64);
+
+        /* Load the file via the virtual drive. The run-ahead instance is
+         * synchronized every two cycles. Hence, the trap is the only writer
+         * between the last synchronization and the comparison below.
+         */
+        c64.keyboard.autoType("load\"*\",8,1\n");
+        auto timeout = c64.cpu.clock + 10 * PAL::CYCLES_PER_SECOND;
+        while (c64.cpu.clock < timeout && c64.vdrive.getInfo().device[0].loads == 0) {
+            ahead->syncWith(c64);
+            c64.fastForwardCycles(2);
+        }
+        report("Virtual LOAD executed", c64.vdrive.getInfo().device[0].loads == 1);
+        report("File copied into memory", c64.mem.spypeek(0xC000) == prg[2] &&
+                                          c64.mem.spypeek(0xCFFF) == prg.back());
+
+        // Synchronize the run-ahead instance incrementally and compare
+        ahead->syncWith(c64);
+        report("Incremental sync after LOAD matches", *ahead == c64);
+
+        emu.resume();
+    }
+
+    emu.set(Opt::C64_MAX_SPEED, false);
+    std::filesystem::remove_all(dir);
+}
+
+void
+Headless::checkAudioStream()
+{
+    VirtualC64 emu;
+
+    emu.c64.installOpenRoms();
+    emu.c64.deleteRom(RomType::VC1541);
+    emu.set(Opt::DRV_CONNECT, false, 0);
+    emu.set(Opt::DRV_CONNECT, false, 1);
+
+    // Overflows are only counted while the emulator is running
+    emu.launch();
+    emu.run();
+
+    // Wait until the emulator thread has processed the run command
+    for (isize i = 0; i < 100 && !emu.isRunning(); i++) utl::Time::milliseconds(10).sleep();
+
+    {   emu.suspend();
+
+        auto &c64 = *emu.c64.c64;
+        auto &port = c64.audioPort;
+        auto &stream = port.stream;
+        auto cap = stream.cap();
+
+        std::vector<float> l(cap), r(cap);
+
+        // Drain the stream and fill it up with numbered samples
+        stream.copyStereo(l.data(), r.data(), stream.count());
+        for (isize i = 0; i < cap; i++) stream.write(SamplePair { float(i), float(i) });
+        report("Stream filled", stream.count() == cap);
+
+        // Emulate a frame without a consumer, which causes an overflow
+        auto overflows = port.getStats().bufferOverflows;
+        c64.fastForward(1);
+        report("Overflow counted once", port.getStats().bufferOverflows == overflows + 1);
+
+        // The oldest half should be gone and the newest half be preserved
+        auto count = stream.count();
+        stream.copyStereo(l.data(), r.data(), count);
+        report("New samples accepted", count > cap / 2);
+        report("Oldest samples dropped", l[0] == float(cap / 2) && l[cap / 2 - 1] == float(cap - 1));
+
+        emu.resume();
+    }
+
+    emu.pause();
+}
+
+void
+Headless::checkTextures()
+{
+    VirtualC64 emu;
+
+    emu.c64.installOpenRoms();
+    emu.c64.deleteRom(RomType::VC1541);
+    emu.set(Opt::DRV_CONNECT, false, 0);
+    emu.set(Opt::DRV_CONNECT, false, 1);
+
+    // Textures can only be acquired if the emulator is powered on
+    emu.launch();
+    emu.powerOn();
+
+    // Wait until the emulator thread has processed the power-on command
+    for (isize i = 0; i < 100 && !emu.isPoweredOn(); i++) utl::Time::milliseconds(10).sleep();
+
+    {   emu.suspend();
+
+        auto &c64 = *emu.c64.c64;
+        auto &port = c64.videoPort;
+
+        c64.hardReset();
+        c64.fastForward(10);
+
+        // Let two consumers grab the same texture
+        auto &gui = port.acquireTexture(0, TEX_CONSUMER_GUI);
+        auto &rpc = port.acquireTexture(0, TEX_CONSUMER_RPC);
+        report("Both consumers hold the same texture", &gui == &rpc);
+
+        auto nr = gui.nr;
+        auto pixels = std::vector<u32>(gui.pixels.ptr, gui.pixels.ptr + Texture::texels);
+
+        // Release the texture by one consumer and cycle through all buffers
+        port.releaseTexture(TEX_CONSUMER_RPC);
+        c64.fastForward(32);
+
+        report("Texture kept by the other consumer",
+               gui.nr == nr && std::equal(pixels.begin(), pixels.end(), gui.pixels.ptr));
+
+        /* Once released by both consumers, the texture is recycled. By now, it
+         * has been moved to the spare textures. It is swapped back into the
+         * ring buffer when the emulator hits another pinned texture.
+         */
+        port.releaseTexture(TEX_CONSUMER_GUI);
+        port.acquireTexture(0, TEX_CONSUMER_RPC);
+        c64.fastForward(32);
+        port.releaseTexture(TEX_CONSUMER_RPC);
+        report("Texture recycled after release", gui.nr != nr);
+
+        emu.resume();
+    }
+
+    emu.powerOff();
+}
+
+void
+Headless::checkBlockExecution()
+{
+    // A BASIC program causing sprite DMA, CIA timer events, and VICII accesses
+    const char *program =
+    "10 poke53269,255:poke53271,255:poke53277,255\n"
+    "20 fori=0to15:poke53248+i,i*16:next\n"
+    "30 poke56580,rnd(1)*255:poke56581,1:poke56590,17\n"
+    "40 poke53280,peek(53266):goto30\n"
+    "run\n";
+
+    // Records the state of the emulator while the program is running
+    auto record = [&](bool blocks) {
+
+        std::vector<std::pair<Cycle, u64>> result;
+        VirtualC64 emu;
+
+        emu.c64.installOpenRoms();
+        emu.c64.deleteRom(RomType::VC1541);
+        emu.set(Opt::DRV_CONNECT, false, 0);
+        emu.set(Opt::DRV_CONNECT, false, 1);
+        emu.set(Opt::C64_BLOCK_EXEC, blocks);
+
+        // Launch the emulator thread (the instance is never powered on)
+        emu.launch();
+
+        {   emu.suspend();
+
+            auto &c64 = *emu.c64.c64;
+
+            c64.hardReset();
+            c64.fastForward(isize(3 * c64.refreshRate()));
+
+            c64.keyboard.autoType(program);
+            for (isize i = 0; i < 20; i++) {
+
+                c64.fastForward(50);
+                result.push_back({ c64.cpu.clock, c64.checksum(true) });
+            }
+
+            emu.resume();
+        }
+
+        return result;
+    };
+
+    auto slow = record(false);
+    auto fast = record(true);
+
+    report("Same cycle counts", std::equal(slow.begin(), slow.end(), fast.begin(),
+                                           [](auto &a, auto &b) { return a.first == b.first; }));
+    report("Same emulator states", slow == fast);
+}
+
+void
+Headless::checkDriveRead()
+{
+    struct Sample { Cycle clock; HeadPos offset; u64 via2; u64 drive; std::vector<u8> ram; };
+
+    // Records the state of a drive while the test firmware reads the disk
+    auto record = [&](bool fast) {
+
+        std::vector<Sample> result;
+        VirtualC64 emu;
+
+        emu.c64.installOpenRoms();
+
+        // Without power-saving, carry pulses are processed one by one
+        emu.set(Opt::DRV_POWER_SAVE, fast, 0);
+        launchTestDrives(emu, 1);
+
+        {   emu.suspend();
+
+            auto &c64 = *emu.c64.c64;
+            auto &drive = c64.drive8;
+
+            c64.hardReset();
+            for (isize i = 0; i < 100; i++) {
+
+                c64.fastForward(5);
+
+                // Process all deferred carry pulses
+                drive.catchUp();
+
+                /* The checksum of the drive itself includes the DRV_POWER_SAVE
+                 * setting. Hence, only the subcomponents are compared.
+                 */
+                u64 state = utl::Hashable::fnvInit64();
+                for (auto *c : drive.subComponents) {
+                    state = utl::Hashable::fnvIt64(state, c->checksum(true));
+                }
+
+                result.push_back({ drive.cpu.clock,
+                                   drive.getOffset(),
+                                   drive.via2.checksum(false),
+                                   state,
+                                   std::vector<u8>(drive.mem.ram + 0x300, drive.mem.ram + 0x500) });
+            }
+
+            emu.resume();
+        }
+
+        emu.powerOff();
+        return result;
+    };
+
+    auto slow = record(false);
+    auto fast = record(true);
+
+    auto same = [&](auto member) {
+        return std::equal(slow.begin(), slow.end(), fast.begin(),
+                          [&](auto &a, auto &b) { return a.*member == b.*member; });
+    };
+
+    // Make sure the firmware has seen SYNC marks and sector headers (GCR byte $52)
+    auto syncs = std::count_if(slow.begin(), slow.end(), [](auto &s) {
+        return std::any_of(s.ram.begin() + 0x100, s.ram.end(), [](u8 pb) { return !(pb & 0x80); });
+    });
+    auto headers = std::count_if(slow.begin(), slow.end(), [](auto &s) {
+        return std::find(s.ram.begin(), s.ram.begin() + 0x100, 0x52) != s.ram.begin() + 0x100;
+    });
+
+    report("SYNC marks detected", syncs > 0);
+    report("Sector headers read", headers > 0);
+    report("Same drive clocks", same(&Sample::clock));
+    report("Same head positions", same(&Sample::offset));
+    report("Same bytes and SYNC bits read", same(&Sample::ram));
+    report("Same VIA2 states", same(&Sample::via2));
+    report("Same drive CPU, memory, and VIA states", same(&Sample::drive));
+}
+
+void
+Headless::checkDriveThread()
+{
+    // A BASIC program toggling the CLOCK and DATA lines of the serial bus
+    const char *program =
+    "10 poke56576,peek(56576)eor48:poke1024,peek(56576):goto10\n"
+    "run\n";
+
+    struct Sample { Cycle clock; u64 ram; u64 drive8; u64 drive9; };
+
+    // Records the emulator state while both drives interact with the C64
+    auto record = [&](bool threaded) {
+
+        std::vector<Sample> result;
+        VirtualC64 emu;
+
+        emu.c64.installOpenRoms();
+        emu.set(Opt::C64_DRIVE_THREAD, threaded);
+        launchTestDrives(emu, 2);
+
+        {   emu.suspend();
+
+            auto &c64 = *emu.c64.c64;
+
+            c64.hardReset();
+            c64.fastForward(isize(3 * c64.refreshRate()));
+
+            c64.keyboard.autoType(program);
+            for (isize i = 0; i < 50; i++) {
+
+                c64.fastForward(5);
+                c64.drive8.catchUp();
+                c64.drive9.catchUp();
+
+                result.push_back({ c64.cpu.clock,
+                                   utl::Hashable::fnv64(c64.mem.ram, sizeof(c64.mem.ram)),
+                                   c64.drive8.checksum(true),
+                                   c64.drive9.checksum(true) });
+            }
+
+            emu.resume();
+        }
+
+        emu.powerOff();
+        return result;
+    };
+
+    auto inlined = record(false);
+    auto threaded = record(true);
+
+    auto same = [&](auto member) {
+        return std::equal(inlined.begin(), inlined.end(), threaded.begin(),
+                          [&](auto &a, auto &b) { return a.*member == b.*member; });
+    };
+
+    report("Same CPU clocks", same(&Sample::clock));
+    report("Same RAM contents", same(&Sample::ram));
+    report("Same drive 8 states", same(&Sample::drive8));
+    report("Same drive 9 states", same(&Sample::drive9));
+}
+
+void
+Headless::checkCIASleep()
+{
+    // Timer setups (CRA, CRB) with PB6 / PB7 in toggle or pulse mode
+    const std::pair<u8, u8> modes[] = {
+
+        { 0x17, 0x00 },         // Timer A continuous, PB6 toggles
+        { 0x13, 0x00 },         // Timer A continuous, PB6 pulses
+        { 0x00, 0x17 },         // Timer B continuous, PB7 toggles
+        { 0x13, 0x13 },         // Both timers continuous, PB6 and PB7 pulse
+        { 0x11, 0x57 },         // Timer B counts underflows, PB7 toggles
+        { 0x17, 0x53 }          // Timer B counts underflows, PB7 pulses
+    };
+
+    // Latch values (the first two are close to the lower bound for skipping)
+    const u16 latches[] = { 8, 9, 31, 300 };
+
+    // Records the observable timer state while the CIA sleeps and wakes up
+    auto record = [&](bool sleep, double &idle) {
+
+        std::vector<u8> result;
+        VirtualC64 emu;
+
+        emu.c64.installOpenRoms();
+        emu.c64.deleteRom(RomType::VC1541);
+        emu.set(Opt::DRV_CONNECT, false, 0);
+        emu.set(Opt::DRV_CONNECT, false, 1);
+        emu.set(Opt::CIA_IDLE_SLEEP, sleep);
+
+        // Launch the emulator thread (the instance is never powered on)
+        emu.launch();
+
+        {   emu.suspend();
+
+            auto &c64 = *emu.c64.c64;
+            auto &cia = c64.cia2;
+
+            c64.hardReset();
+            c64.fastForward(isize(3 * c64.refreshRate()));
+            cia.getStats();
+
+            for (auto &mode : modes) {
+
+                for (auto latch : latches) {
+
+                    // Disable interrupts and restart both timers
+                    cia.poke(0x0D, 0x7F);
+                    cia.poke(0x0E, 0x00);
+                    cia.poke(0x0F, 0x00);
+                    cia.poke(0x04, LO_BYTE(latch));
+                    cia.poke(0x05, HI_BYTE(latch));
+                    cia.poke(0x06, 3);
+                    cia.poke(0x07, 0);
+                    cia.poke(0x0E, mode.first);
+                    cia.poke(0x0F, mode.second);
+
+                    // Wake up the CIA in every phase of the timer period
+                    auto start = c64.cpu.clock;
+                    for (isize phase = 0; phase <= latch; phase++) {
+
+                        auto target = start + (4 * phase + 16) * (latch + 1) + phase;
+                        c64.fastForwardCycles(target - c64.cpu.clock);
+
+                        result.push_back(cia.peek(0x01) & 0xC0);
+                        for (u16 reg : { 0x04, 0x05, 0x06, 0x07, 0x0D }) {
+                            result.push_back(cia.spypeek(reg));
+                        }
+                    }
+                }
+            }
+
+            idle = cia.getStats().idlePercentage;
+            emu.resume();
+        }
+
+        return result;
+    };
+
+    double idle[2];
+    auto awake = record(false, idle[0]);
+    auto sleepy = record(true, idle[1]);
+
+    report("Same counters, ICR and PB6 / PB7 bits", awake == sleepy);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "CIA 2 idle percentage: " << 100.0 * idle[0] << " (no sleep), ";
+    std::cout << 100.0 * idle[1] << " (idle sleep)" << std::endl;
+}
+
 void
 process(const void *listener, Message msg)
 {
@@ -281,6 +1446,18 @@ Headless::smokeTestScript[] = {
     "regression set WATCHDOG 1000000",
     "regression set WATCHDOG 0",
 
+    "rewind",
+    "rewind set BUDGET 16",
+    "rewind frames 10",
+    "rewind seconds 1",
+    "rewind clear",
+    "rewind set BUDGET 0",
+
+    "trace",
+    "trace set SIZE 1",
+    "trace set DRIVES true",
+    "trace set DRIVES false",
+
     "# ",
     "# Components",
     "# ",
@@ -293,7 +1470,17 @@ Headless::smokeTestScript[] = {
     "c64 set SPEED_BOOST 75",
     "c64 set VSYNC yes",
     "c64 set VSYNC no",
+    "c64 set MAX_SPEED yes",
+    "c64 set MAX_SPEED no",
     "c64 set RUN_AHEAD 2",
+    "c64 set DRIVE_THREAD yes",
+    "c64 set DRIVE_THREAD no",
+    "c64 set SID_THREAD yes",
+    "c64 set SID_THREAD no",
+    "c64 set SLICES 4",
+    "c64 set SLICES 1",
+    "c64 set BLOCK_EXEC no",
+    "c64 set BLOCK_EXEC yes",
     "c64 defaults",
     "c64 reset",
     "c64 init PAL",
@@ -503,6 +1690,13 @@ Headless::smokeTestScript[] = {
     "drive9 newdisk NODOS",
     "drive9 newdisk CBM",
 
+    "vdrive",
+    "vdrive set FALLBACK false",
+    "vdrive set FALLBACK true",
+    "vdrive set ENABLE true",
+    "vdrive set ENABLE false",
+    "vdrive detach 10",
+
     "datasette",
     "datasette set MODEL C1530",
     "datasette rewind",
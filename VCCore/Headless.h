@@ -57,6 +57,35 @@ private:
     // Runs a RetroShell script
     void runScript(const char **script);
     void runScript(const fs::path &path);
+
+    // Runs the specified files on a pool of emulator instances
+    void runBatch();
+
+    // Runs a micro benchmark
+    void runBenchmark(const string &name);
+    void benchmarkVICII();
+    void benchmarkGuards();
+    void benchmarkBlocks();
+    void benchmarkDrives();
+    void benchmarkRunAhead();
+    void benchmarkTracer();
+    void benchmarkMemory();
+
+    // Runs a consistency check
+    void runCheck(const string &name);
+    void checkVirtualDrive();
+    void checkAudioStream();
+    void checkTextures();
+    void checkBlockExecution();
+    void checkDriveRead();
+    void checkDriveThread();
+    void checkCIASleep();
+
+    // Reports the outcome of a consistency check
+    void report(const string &check, bool success);
+
+    // Launches an emulator with 'count' drives running a test firmware
+    void launchTestDrives(VirtualC64 &emu, isize count);
     
 
     //
@@ -45,6 +45,7 @@ enum class Cmd : long
     ALARM_ABS,              ///< Schedule an alarm (absolute cycle)
     ALARM_REL,              ///< Schedule an alarm (relative cycle)
     INSPECTION_TARGET,      ///< Sets the auto-inspection mask
+    REWIND,                 ///< Revert to a recorded frame
     
     // CPU
     CPU_BRK,                ///< Let the CPU execute a BRK instruction
@@ -141,6 +142,7 @@ struct CmdEnum : Reflectable<CmdEnum, Cmd> {
             case Cmd::ALARM_ABS:             return "ALARM_ABS";
             case Cmd::ALARM_REL:             return "ALARM_REL";
             case Cmd::INSPECTION_TARGET:     return "INSPECTION_TARGET";
+            case Cmd::REWIND:                return "REWIND";
 
             case Cmd::CPU_BRK:               return "CPU_BRK";
             case Cmd::CPU_NMI:               return "CPU_NMI";
@@ -285,6 +287,24 @@ struct Command
     Command(Cmd type, const GamePadCmd &cmd) : type(type), action(cmd) { }
     Command(Cmd type, const KeyCmd &cmd) : type(type), key(cmd) { }
     Command(Cmd type, const TapeCmd &cmd) : type(type), tape(cmd) { }
+
+    // Checks if this command reports a keyboard, mouse, or joystick event
+    bool isInputEvent() const {
+
+        switch (type) {
+
+            case Cmd::KEY_PRESS:
+            case Cmd::KEY_RELEASE:
+            case Cmd::KEY_RELEASE_ALL:
+            case Cmd::KEY_TOGGLE:
+            case Cmd::MOUSE_MOVE_ABS:
+            case Cmd::MOUSE_MOVE_REL:
+            case Cmd::MOUSE_BUTTON:
+            case Cmd::JOY_EVENT:    return true;
+
+            default:                return false;
+        }
+    }
 };
 
 }
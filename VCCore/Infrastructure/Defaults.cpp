@@ -28,7 +28,12 @@ Defaults::Defaults()
     setFallback(Opt::C64_WARP_MODE,              (i64)Warp::NEVER);
     setFallback(Opt::C64_VSYNC,                  false);
     setFallback(Opt::C64_SPEED_BOOST,            100);
+    setFallback(Opt::C64_MAX_SPEED,              false);
     setFallback(Opt::C64_RUN_AHEAD,              0);
+    setFallback(Opt::C64_DRIVE_THREAD,           false);
+    setFallback(Opt::C64_SID_THREAD,             false);
+    setFallback(Opt::C64_SLICES,                 1);
+    setFallback(Opt::C64_BLOCK_EXEC,             true);
 
     setFallback(Opt::DASM_NUMBERS,               (i64)DasmNumbers::HEX0);
     
@@ -147,6 +152,9 @@ Defaults::Defaults()
     setFallback(Opt::DAT_MODEL,                  (i64)DatasetteModel::C1530);
     setFallback(Opt::DAT_CONNECT,                true);
 
+    setFallback(Opt::VDR_ENABLE,                 false);
+    setFallback(Opt::VDR_FALLBACK,               true);
+
     setFallback(Opt::MOUSE_MODEL,                (i64)MouseModel::C1350);
     setFallback(Opt::MOUSE_SHAKE_DETECT,         true);
     setFallback(Opt::MOUSE_VELOCITY,             100);
@@ -183,6 +191,11 @@ Defaults::Defaults()
     setFallback(Opt::SRV_TRANSPORT,               (i64)TransportProtocol::HTTP, { (i64)ServerType::PROM });
     setFallback(Opt::SRV_VERBOSE,                true,                   { (i64)ServerType::PROM });
 
+    setFallback(Opt::REW_BUDGET,                 0);
+
+    setFallback(Opt::TRC_DRIVES,                 false);
+    setFallback(Opt::TRC_SIZE,                   64);
+
     setFallback(Opt::DBG_DEBUGCART,              0);
     setFallback(Opt::DBG_WATCHDOG,               0);
 
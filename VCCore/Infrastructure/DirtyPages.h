@@ -0,0 +1,83 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "BasicTypes.h"
+#include <bit>
+
+namespace vc64 {
+
+/* Keeps track of the memory pages that have been modified since the last call
+ * to clear(). The run-ahead logic utilizes this information to synchronize the
+ * run-ahead instance with the main instance without copying memory areas that
+ * are identical in both instances anyway.
+ *
+ * A dirty-page map is bookkeeping information and not part of the emulator
+ * state. Hence, it is neither serialized nor cloned.
+ */
+template <isize N> class DirtyPages {
+
+    static constexpr isize words = (N + 63) / 64;
+
+    // One bit per page
+    u64 bits[words] = { };
+
+public:
+
+    // Marks a single page as modified
+    void mark(isize nr) { assert(nr >= 0 && nr < N); bits[nr >> 6] |= u64(1) << (nr & 63); }
+
+    // Marks all pages as modified
+    void markAll() { for (isize i = 0; i < N; i++) mark(i); }
+
+    // Marks all pages as unmodified
+    void clear() { for (isize i = 0; i < words; i++) bits[i] = 0; }
+
+    // Checks if a certain page has been modified
+    bool test(isize nr) const { return (bits[nr >> 6] >> (nr & 63)) & 1; }
+
+    // Checks if any page has been modified
+    bool any() const {
+
+        for (isize i = 0; i < words; i++) if (bits[i]) return true;
+        return false;
+    }
+
+    // Counts the number of modified pages
+    isize count() const {
+
+        isize result = 0;
+        for (isize i = 0; i < words; i++) result += std::popcount(bits[i]);
+        return result;
+    }
+
+    // Merges in the modified pages of another map
+    DirtyPages<N>& operator|= (const DirtyPages<N> &other) {
+
+        for (isize i = 0; i < words; i++) bits[i] |= other.bits[i];
+        return *this;
+    }
+
+    // Calls a function for each modified page
+    template <class F> void forEach(F func) const {
+
+        for (isize i = 0; i < words; i++) {
+
+            for (u64 w = bits[i]; w; w &= w - 1) {
+                func((i << 6) + std::countr_zero(w));
+            }
+        }
+    }
+};
+
+}
@@ -121,6 +121,12 @@ Emulator::_dump(Category category, std::ostream &os) const
 
         os << tab("Clone nr");
         os << dec(stats.clones) << std::endl;
+        os << tab("Clone time");
+        os << flt(stats.cloneTime) << " usec" << std::endl;
+        os << tab("Update nr");
+        os << dec(stats.syncs) << std::endl;
+        os << tab("Update time");
+        os << flt(stats.syncTime) << " usec" << std::endl;
         os << tab("Frame");
         os << dec(ahead.frame) << std::endl;
         os << tab("Beam");
@@ -145,6 +151,26 @@ Emulator::_dump(Category category, std::ostream &os) const
         os << bol(isTracking()) << std::endl;
         os << std::endl;
     }
+
+    if (category == Category::Stats) {
+
+        auto stats = getStats();
+
+        os << tab("CPU load");
+        os << flt(stats.cpuLoad * 100.0) << " %" << std::endl;
+        os << tab("Frames per second");
+        os << flt(stats.fps) << std::endl;
+        os << tab("Cycles per second");
+        os << dec(i64(stats.cps)) << std::endl;
+        os << tab("Speed-up");
+        os << flt(stats.speedup) << "x" << std::endl;
+        os << tab("Resyncs");
+        os << dec(stats.resyncs) << std::endl;
+        os << tab("Auto-snapshots");
+        os << dec(stats.snapshots) << std::endl;
+        os << tab("Snapshot stall");
+        os << flt(stats.snapshotStall) << " usec" << std::endl;
+    }
 }
 
 void
@@ -169,6 +195,8 @@ Emulator::cacheStats(EmulatorStats &result) const
 
         result.cpuLoad = cpuLoad;
         result.fps = fps;
+        result.cps = cps;
+        result.speedup = cps / double(main.nativeClockFrequency());
         result.resyncs = resyncs;
     }
 }
@@ -242,7 +270,12 @@ Emulator::shouldWarp() const
 {
     auto &config = main.getConfig();
 
-    if (main.cpu.clock < C64::sec(config.warpBoot)) {
+    if (config.maxSpeed) {
+
+        // Never throttle in max-speed mode
+        return true;
+
+    } else if (main.cpu.clock < C64::sec(config.warpBoot)) {
 
         return true;
 
@@ -271,19 +304,38 @@ Emulator::missingFrames() const
     // Compute the elapsed time
     auto elapsed = utl::Time::now() - baseTime;
 
-    // Compute which frame should be reached by now
-    auto target = elapsed.asNanoseconds() * i64(main.refreshRate()) / 1000000000;
+    // Compute which frame (or time slice) should be reached by now
+    auto target = elapsed.asNanoseconds() * i64(main.refreshRate()) * slicesPerFrame() / 1000000000;
 
     // Compute the number of missing frames
     return isize(target - frameCounter);
 }
 
+isize
+Emulator::slicesPerFrame() const
+{
+    auto &config = main.getConfig();
+
+    // Slices require self-paced execution of the main instance only
+    if (config.vsync || config.runAhead > 0 || isWarping()) return 1;
+
+    return config.slices;
+}
+
+utl::Time
+Emulator::nextSliceTime() const
+{
+    auto rate = i64(main.refreshRate()) * slicesPerFrame();
+    return baseTime + utl::Time::nanoseconds((frameCounter + 1) * 1000000000 / rate);
+}
+
 void
 Emulator::computeFrame()
 {
     auto &config = main.getConfig();
 
-    if (config.runAhead > 0) {
+    // Skip run-ahead in max-speed mode as no frames are displayed anyway
+    if (config.runAhead > 0 && !config.maxSpeed) {
 
         try {
 
@@ -298,17 +350,23 @@ Emulator::computeFrame()
 
         } catch (StateChangeException &) {
 
-            isDirty = true;
+            markAsDirty();
             throw;
         }
 
     } else {
 
         // Only run the main instance
-        main.computeFrame();
+        main.computeSlice(slicesPerFrame());
     }
 }
 
+i64
+Emulator::emulatedCycles() const
+{
+    return main.cpu.clock;
+}
+
 void
 Emulator::isReady()
 {
@@ -318,10 +376,26 @@ Emulator::isReady()
 void
 Emulator::cloneRunAheadInstance()
 {
-    stats.clones++;
+    auto start = utl::Time::now();
+
+    if (needsFullClone) {
+
+        // Recreate the runahead instance from scratch
+        ahead = main; isDirty = needsFullClone = false;
 
-    // Recreate the runahead instance from scratch
-    ahead = main; isDirty = false;
+        auto elapsed = double((utl::Time::now() - start).asNanoseconds()) / 1000.0;
+        stats.clones++;
+        stats.cloneTime += (elapsed - stats.cloneTime) / double(stats.clones);
+
+    } else {
+
+        // Only copy what has been modified since the last update
+        ahead.syncWith(main); isDirty = false;
+
+        auto elapsed = double((utl::Time::now() - start).asNanoseconds()) / 1000.0;
+        stats.syncs++;
+        stats.syncTime += (elapsed - stats.syncTime) / double(stats.syncs);
+    }
 
     if constexpr (debug::RUA_CHECKSUM) {
         
@@ -444,17 +518,20 @@ Emulator::getTexture() const
 
         // In run-ahead mode, return the texture from the run-ahead instance
         if (main.config.runAhead > 0) {
-            return ahead.videoPort.getTexture();
+            main.videoPort.releaseTexture();
+            return ahead.videoPort.acquireTexture();
         }
 
         // In run-behind mode, return a texture from the texture buffer
         if (main.config.runAhead < 0) {
-            return main.videoPort.getTexture(main.config.runAhead);
+            ahead.videoPort.releaseTexture();
+            return main.videoPort.acquireTexture(main.config.runAhead);
         }
     }
 
     // Return the most recent texture from the main instance
-    return main.videoPort.getTexture();
+    ahead.videoPort.releaseTexture();
+    return main.videoPort.acquireTexture();
 }
 
 /*
@@ -481,17 +558,39 @@ Emulator::getDmaTexture() const
 
         // In run-ahead mode, return the texture from the run-ahead instance
         if (main.config.runAhead > 0) {
-            return ahead.videoPort.getDmaTexture();
+            main.videoPort.releaseDmaTexture();
+            return ahead.videoPort.acquireDmaTexture();
         }
 
         // In run-behind mode, return a texture from the texture buffer
         if (main.config.runAhead < 0) {
-            return main.videoPort.getDmaTexture(main.config.runAhead);
+            ahead.videoPort.releaseDmaTexture();
+            return main.videoPort.acquireDmaTexture(main.config.runAhead);
         }
     }
 
     // Return the most recent texture from the main instance
-    return main.videoPort.getDmaTexture();
+    ahead.videoPort.releaseDmaTexture();
+    return main.videoPort.acquireDmaTexture();
+}
+
+void
+Emulator::releaseTextures() const
+{
+    main.videoPort.releaseTexture();
+    main.videoPort.releaseDmaTexture();
+    ahead.videoPort.releaseTexture();
+    ahead.videoPort.releaseDmaTexture();
+}
+
+void
+Emulator::compressSnapshot(Snapshot *snapshot, Compressor compressor, utl::Time start)
+{
+    snapshotWorker.put(snapshot, compressor);
+
+    auto elapsed = double((utl::Time::now() - start).asNanoseconds()) / 1000.0;
+    stats.snapshots++;
+    stats.snapshotStall += (elapsed - stats.snapshotStall) / double(stats.snapshots);
 }
 
 void
@@ -18,6 +18,7 @@
 #include "Host.h"
 #include "Thread.h"
 #include "CmdQueue.h"
+#include "SnapshotWorker.h"
 
 namespace vc64 {
 
@@ -42,12 +43,18 @@ private:
     // Indicates if the run-ahead instance needs to be updated
     bool isDirty = true;
 
+    // Indicates if the update can't be performed incrementally
+    bool needsFullClone = true;
+
     // Incoming external events
     CmdQueue cmdQueue;
 
     // Texture lock
     utl::Mutex textureLock;
 
+    // Background compressor for auto-snapshots
+    SnapshotWorker snapshotWorker { main.msgQueue };
+
 
     //
     // Methods
@@ -65,7 +72,7 @@ public:
     void initialize() override;
 
     // Forces to recreate the run-ahead instance in the next frame
-    void markAsDirty() { isDirty = true; }
+    void markAsDirty() { isDirty = needsFullClone = true; }
 
 
     //
@@ -126,7 +133,10 @@ private:
     void update() override;
     bool shouldWarp() const;
     isize missingFrames() const override;
+    isize slicesPerFrame() const override;
+    utl::Time nextSliceTime() const override;
     void computeFrame() override;
+    i64 emulatedCycles() const override;
 
     void _powerOn() override { main.powerOn(); }
     void _powerOff() override { main.powerOff(); }
@@ -175,7 +185,17 @@ public:
 
     const Texture &getTexture() const;
     const Texture &getDmaTexture() const;
+    void releaseTextures() const;
+
+
+    //
+    // Snapshots
+    //
+
+    // Compresses a snapshot in the background and hands it over to the GUI
+    void compressSnapshot(Snapshot *snapshot, Compressor compressor, utl::Time start);
 
+    // Deprecated (textures are handed over without locking)
     void lockTexture() { textureLock.lock(); }
     void unlockTexture() { textureLock.unlock(); }
 
@@ -331,8 +331,15 @@ typedef struct
 {
     double cpuLoad;         ///< Measured CPU load
     double fps;             ///< Measured frames per seconds
+    double cps;             ///< Measured emulated CPU cycles per second
+    double speedup;         ///< Emulation speed relative to a real C64
     isize resyncs;          ///< Number of out-of-sync conditions
     isize clones;           ///< Number of created run-ahead instances
+    isize syncs;            ///< Number of incremental run-ahead updates
+    double cloneTime;       ///< Average duration of a full clone in usec
+    double syncTime;        ///< Average duration of an incremental update in usec
+    isize snapshots;        ///< Number of auto-snapshots
+    double snapshotStall;   ///< Average emulator stall per auto-snapshot in usec
 }
 EmulatorStats;
 
@@ -287,12 +287,11 @@ Host::tmp() const
 {
     SYNCHRONIZED
 
-    static fs::path base;
-
-    if (base.empty()) {
+    // The static is shared by all emulator instances and initialized only once
+    static const fs::path base = []() {
 
         // Use /tmp as default folder for temporary files
-        base = "/tmp";
+        fs::path base = "/tmp";
 
         // Open a file to see if we have write permissions
         std::ofstream logfile(base / "virtualc64.log");
@@ -311,7 +310,9 @@ Host::tmp() const
 
         logfile.close();
         fs::remove(base / "virtualc64.log");
-    }
+
+        return base;
+    }();
 
     return base;
 }
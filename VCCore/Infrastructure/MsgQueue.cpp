@@ -15,6 +15,22 @@
 
 namespace vc64 {
 
+MsgQueue::MsgQueue()
+{
+    for (isize i = 0; i < capacity; i++) slots[i].seq.store(i, std::memory_order_relaxed);
+}
+
+MsgQueue::~MsgQueue()
+{
+    if (dispatcher.joinable()) {
+
+        quit = true;
+        signal.fetch_add(1, std::memory_order_release);
+        signal.notify_one();
+        dispatcher.join();
+    }
+}
+
 void
 MsgQueue::setListener(const void *listener, Callback *callback)
 {
@@ -22,14 +38,10 @@ MsgQueue::setListener(const void *listener, Callback *callback)
 
         this->listener = listener;
         this->callback = callback;
-
-        // Send all pending messages
-        while (!queue.isEmpty()) {
-
-            Message &msg = queue.read();
-            callback(listener, msg);
-        }
     }
+
+    // Launch the dispatcher which also sends all pending messages
+    if (!dispatcher.joinable()) dispatcher = std::thread(&MsgQueue::main, this);
 }
 
 bool
@@ -39,37 +51,157 @@ MsgQueue::get(Message &msg)
 
     {   SYNCHRONIZED
 
-        if (queue.isEmpty()) return false;
+        // If a listener is registered, the dispatcher is the only consumer
+        if (listener) return false;
 
-        msg = queue.read();
-        return true;
+        return read(msg);
     }
 }
 
+bool
+MsgQueue::read(Message &msg)
+{
+    auto &slot = slots[r % capacity];
+
+    // Check if the slot has been published
+    if (slot.seq.load(std::memory_order_acquire) != r + 1) return false;
+
+    // Read the message and hand the slot back to the producers
+    msg = slot.msg;
+    slot.seq.store(r + capacity, std::memory_order_release);
+    r++;
+
+    return true;
+}
+
 void
 MsgQueue::put(const Message &msg)
 {
-    if (enabled) {
+    if (!enabled) return;
+
+    loginfo(MSG_DEBUG, "%s [%llx]\n", MsgEnum::key(msg.type), msg.value);
 
-        SYNCHRONIZED
+    // Claim a slot
+    auto pos = w.load(std::memory_order_relaxed);
 
-        loginfo(MSG_DEBUG, "%s [%llx]\n", MsgEnum::key(msg.type), msg.value);
+    while (true) {
 
-        if (listener) {
+        auto diff = slots[pos % capacity].seq.load(std::memory_order_acquire) - pos;
 
-            // Send the message immediately if a lister has been registered
-            callback(listener, msg);
+        if (diff == 0) {
+
+            // The slot is free. Try to claim it
+            if (w.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+
+        } else if (diff < 0) {
+
+            // The ring buffer is full
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            logwarn("Message lost: %s [%llx]\n", MsgEnum::key(msg.type), msg.value);
+            return;
 
         } else {
 
-            // Otherwise, store it in the ring buffer
-            if (!queue.isFull()) {
-                queue.write(msg);
-            } else {
-                logwarn("Message lost: %s [%llx]\n", MsgEnum::key(msg.type), msg.value);
+            // Another producer has claimed the slot
+            pos = w.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Publish the message
+    auto &slot = slots[pos % capacity];
+    slot.msg = msg;
+    slot.seq.store(pos + 1, std::memory_order_release);
+
+    // Wake up the dispatcher unless the message can wait until the frame ends
+    if (coalescingKey(msg) < 0) flush();
+}
+
+void
+MsgQueue::flush()
+{
+    signal.fetch_add(1, std::memory_order_release);
+    signal.notify_one();
+}
+
+isize
+MsgQueue::coalescingKey(const Message &msg)
+{
+    switch (msg.type) {
+
+        case Msg::CONFIG:       return 0;
+        case Msg::RSH_UPDATE:   return 1;
+        case Msg::DRIVE_LED:    return 2 + (msg.drive.nr & 3);
+        case Msg::DRIVE_MOTOR:  return 6 + (msg.drive.nr & 3);
+        case Msg::DRIVE_STEP:   return 10 + (msg.drive.nr & 3);
+
+        default:
+            return -1;
+    }
+}
+
+void
+MsgQueue::dispatch()
+{
+    SYNCHRONIZED
+
+    if (!listener) return;
+
+    // Collect all pending messages
+    Message msg;
+    while (read(msg)) batch.push_back(msg);
+
+    /* Coalesce messages. Walking backwards, we keep the most recent message
+     * of each kind and move it towards the end of the batch. Older messages
+     * of the same kind are skipped.
+     */
+    auto first = batch.end();
+    u64 seen = 0;
+
+    for (auto it = batch.end(); it != batch.begin(); ) {
+
+        if (auto key = coalescingKey(*--it); key >= 0) {
+
+            if (seen & (u64(1) << key)) {
+
+                coalesced.fetch_add(1, std::memory_order_relaxed);
+                continue;
             }
+            seen |= u64(1) << key;
         }
+        *--first = *it;
     }
+
+    // Deliver the remaining messages
+    for (auto it = first; it != batch.end(); it++) {
+
+        callback(listener, *it);
+        dispatched.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    batch.clear();
+}
+
+void
+MsgQueue::main()
+{
+    loginfo(MSG_DEBUG, "Message dispatcher launched\n");
+
+    auto seen = signal.load(std::memory_order_acquire);
+
+    while (!quit) {
+
+        // Deliver all messages that have been published so far
+        dispatch();
+
+        // Wait for new messages
+        signal.wait(seen, std::memory_order_acquire);
+        seen = signal.load(std::memory_order_acquire);
+    }
+
+    // Deliver the remaining messages
+    dispatch();
+
+    loginfo(MSG_DEBUG, "Message dispatcher terminated\n");
 }
 
 void
@@ -15,14 +15,53 @@
 #include "MsgQueueTypes.h"
 #include "CoreObject.h"
 #include "utl/abilities/Synchronizable.h"
-#include "utl/storage/RingBuffer.h"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace vc64 {
 
+/* About the MsgQueue
+ *
+ * The message queue is a lock-free multi-producer, single-consumer ring
+ * buffer. Messages are sent by the emulator thread and by a few helper
+ * threads (drive thread, snapshot worker, remote servers). Producers never
+ * wait. They claim a slot by advancing the write position and publish the
+ * message by updating the sequence number of the slot. If the ring is full,
+ * the message is dropped.
+ *
+ * If a listener has been registered, the ring is drained by a dispatcher
+ * thread which invokes the callback function. Hence, a slow listener does
+ * not stall emulation. Otherwise, the GUI polls the queue via get().
+ *
+ * High-frequency messages (drive LED, motor and head steps, RetroShell
+ * updates, configuration changes) don't wake up the dispatcher. They are
+ * collected until flush() is called once per frame and superseded messages
+ * of the same kind are coalesced.
+ */
 class MsgQueue final : CoreObject, utl::Synchronizable {
 
+public:
+
+    // Number of slots in the ring buffer
+    static constexpr isize capacity = 512;
+
+private:
+
+    // Size of a cache line (used to keep the two sides apart)
+    static constexpr isize cacheLine = 64;
+
+    struct Slot {
+
+        // Equals the position + 1 when the slot has been written
+        std::atomic<i64> seq;
+
+        // The stored message
+        Message msg;
+    };
+
     // Ring buffer storing all pending messages
-    utl::RingBuffer <Message, 512> queue;
+    Slot slots[capacity];
 
     // The registered listener
     const void *listener = nullptr;
@@ -33,10 +72,54 @@ class MsgQueue final : CoreObject, utl::Synchronizable {
     // If disabled, no messages will be stored
     bool enabled = true;
 
+
+    //
+    // Producer side
+    //
+
+    // Number of claimed slots
+    alignas(cacheLine) std::atomic<i64> w = 0;
+
+    // Number of messages lost due to a full ring buffer
+    std::atomic<i64> dropped = 0;
+
+    // Incremented to wake up the dispatcher
+    std::atomic<u32> signal = 0;
+
+
+    //
+    // Consumer side
+    //
+
+    // Number of consumed slots
+    alignas(cacheLine) i64 r = 0;
+
+    // Number of messages discarded by coalescing
+    std::atomic<i64> coalesced = 0;
+
+    // Number of messages handed over to the listener
+    std::atomic<i64> dispatched = 0;
+
+    // Messages collected by the dispatcher
+    std::vector<Message> batch;
+
+    // The dispatcher thread
+    std::thread dispatcher;
+
+    // Indicates if the dispatcher should terminate
+    std::atomic<bool> quit = false;
+
+
     //
     // Constructing
     //
-    
+
+public:
+
+    MsgQueue();
+    ~MsgQueue();
+
+
     //
     // Methods from CoreObject
     //
@@ -67,6 +150,28 @@ public:
     void put(Msg type, CpuMsg payload);
     void put(Msg type, DriveMsg payload);
     void put(Msg type, ScriptMsg payload);
+
+    // Hands over all coalescable messages to the dispatcher (once per frame)
+    void flush();
+
+    // Returns statistical information
+    i64 getDropped() const { return dropped.load(std::memory_order_relaxed); }
+    i64 getCoalesced() const { return coalesced.load(std::memory_order_relaxed); }
+    i64 getDispatched() const { return dispatched.load(std::memory_order_relaxed); }
+
+private:
+
+    // Returns the kind of a coalescable message or -1 if it must not be merged
+    static isize coalescingKey(const Message &msg);
+
+    // Removes a message from the ring buffer (consumer side)
+    bool read(Message &msg);
+
+    // Delivers all pending messages to the listener
+    void dispatch();
+
+    // The main function of the dispatcher thread
+    void main();
 };
 
 }
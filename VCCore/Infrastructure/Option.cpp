@@ -38,7 +38,12 @@ OptionParser::create(Opt opt, i64 arg)
         case Opt::C64_WARP_BOOT:             return numParser(" sec");
         case Opt::C64_VSYNC:                 return boolParser();
         case Opt::C64_SPEED_BOOST:           return numParser("%");
+        case Opt::C64_MAX_SPEED:             return boolParser();
         case Opt::C64_RUN_AHEAD:             return numParser(" frames");
+        case Opt::C64_DRIVE_THREAD:          return boolParser();
+        case Opt::C64_SID_THREAD:            return boolParser();
+        case Opt::C64_SLICES:                return numParser(" slices");
+        case Opt::C64_BLOCK_EXEC:            return boolParser();
 
         case Opt::DASM_NUMBERS:              return enumParser.template operator()<DasmNumbersEnum,DasmNumbers>();
             
@@ -149,6 +154,9 @@ OptionParser::create(Opt opt, i64 arg)
         case Opt::DAT_MODEL:                 return enumParser.template operator()<DatasetteModelEnum,DatasetteModel>();
         case Opt::DAT_CONNECT:               return boolParser();
 
+        case Opt::VDR_ENABLE:                return boolParser();
+        case Opt::VDR_FALLBACK:              return boolParser();
+
         case Opt::MOUSE_MODEL:               return enumParser.template operator()<MouseModelEnum,MouseModel>();
         case Opt::MOUSE_SHAKE_DETECT:        return boolParser();
         case Opt::MOUSE_VELOCITY:            return numParser();
@@ -168,6 +176,11 @@ OptionParser::create(Opt opt, i64 arg)
         case Opt::SRV_TRANSPORT:              return enumParser.template operator()<TransportProtocolEnum,TransportProtocol>();
         case Opt::SRV_VERBOSE:               return boolParser();
 
+        case Opt::REW_BUDGET:                return numParser(" MB");
+
+        case Opt::TRC_DRIVES:                return boolParser();
+        case Opt::TRC_SIZE:                  return numParser(" MB");
+
         case Opt::DBG_DEBUGCART:             return boolParser();
         case Opt::DBG_WATCHDOG:              return numParser();
 
@@ -36,7 +36,12 @@ enum class Opt : long
     C64_WARP_MODE,          ///< Warp activation mode
     C64_VSYNC,              ///< Derive the frame rate to the VSYNC signal
     C64_SPEED_BOOST,        ///< Speed adjustment in percent
+    C64_MAX_SPEED,          ///< Run as fast as possible
     C64_RUN_AHEAD,          ///< Number of run-ahead frames
+    C64_DRIVE_THREAD,       ///< Emulate the drives on a separate thread
+    C64_SID_THREAD,         ///< Synthesize the SID output on a separate thread
+    C64_SLICES,             ///< Number of execution slices per frame
+    C64_BLOCK_EXEC,         ///< Execute the cycles between two events in blocks
 
     // CPU
     DASM_NUMBERS,           ///< Disassembler number format
@@ -164,6 +169,10 @@ enum class Opt : long
     DAT_MODEL,              ///< Datasette model
     DAT_CONNECT,            ///< Connection status
 
+    // Virtual drive
+    VDR_ENABLE,             ///< Serve drives 8 to 11 on the KERNAL level
+    VDR_FALLBACK,           ///< Hand over to the emulated drive if needed
+
     // Mouse
     MOUSE_MODEL,            ///< Mouse model
     MOUSE_SHAKE_DETECT,     ///< Detect a shaking mouse
@@ -188,6 +197,13 @@ enum class Opt : long
     SRV_TRANSPORT,
     SRV_VERBOSE,
 
+    // Rewind buffer
+    REW_BUDGET,             ///< Memory budget in MB
+
+    // Tracer
+    TRC_DRIVES,             ///< Trace the drive CPUs, too
+    TRC_SIZE,               ///< Size of the trace file in MB
+
     // Regression tester
     DBG_DEBUGCART,          ///< Emulate the VICE debug cartridge
     DBG_WATCHDOG,           ///< Watchdog delay in frames
@@ -214,7 +230,12 @@ struct OptEnum : Reflectable<OptEnum, Opt> {
             case Opt::C64_WARP_MODE:         return "C64.WARP_MODE";
             case Opt::C64_VSYNC:             return "C64.VSYNC";
             case Opt::C64_SPEED_BOOST:       return "C64.SPEED_BOOST";
+            case Opt::C64_MAX_SPEED:         return "C64.MAX_SPEED";
             case Opt::C64_RUN_AHEAD:         return "C64.RUN_AHEAD";
+            case Opt::C64_DRIVE_THREAD:      return "C64.DRIVE_THREAD";
+            case Opt::C64_SID_THREAD:        return "C64.SID_THREAD";
+            case Opt::C64_SLICES:            return "C64.SLICES";
+            case Opt::C64_BLOCK_EXEC:        return "C64.BLOCK_EXEC";
 
             case Opt::DASM_NUMBERS:          return "CPU.DASM_NUMBERS";
                 
@@ -326,6 +347,9 @@ struct OptEnum : Reflectable<OptEnum, Opt> {
             case Opt::DAT_MODEL:             return "DAT.MODEL";
             case Opt::DAT_CONNECT:           return "DAT.CONNECT";
 
+            case Opt::VDR_ENABLE:            return "VDR.ENABLE";
+            case Opt::VDR_FALLBACK:          return "VDR.FALLBACK";
+
             case Opt::MOUSE_MODEL:           return "MOUSE.MODEL";
             case Opt::MOUSE_SHAKE_DETECT:    return "MOUSE.SHAKE_DETECTION";
             case Opt::MOUSE_VELOCITY:        return "MOUSE.VELOCITY";
@@ -345,6 +369,11 @@ struct OptEnum : Reflectable<OptEnum, Opt> {
             case Opt::SRV_TRANSPORT:         return "SRV.TRANSPORT";
             case Opt::SRV_VERBOSE:           return "SRV.VERBOSE";
 
+            case Opt::REW_BUDGET:            return "REW.BUDGET";
+
+            case Opt::TRC_DRIVES:            return "TRC.DRIVES";
+            case Opt::TRC_SIZE:              return "TRC.SIZE";
+
             case Opt::DBG_DEBUGCART:         return "DBG.DEBUGCART";
             case Opt::DBG_WATCHDOG:          return "DBG.WATCHDOG";
 
@@ -367,7 +396,12 @@ struct OptEnum : Reflectable<OptEnum, Opt> {
             case Opt::C64_WARP_MODE:         return "Warp activation";
             case Opt::C64_VSYNC:             return "VSYNC mode";
             case Opt::C64_SPEED_BOOST:      return "Speed adjustment";
+            case Opt::C64_MAX_SPEED:         return "Unthrottled execution";
             case Opt::C64_RUN_AHEAD:         return "Run-ahead frames";
+            case Opt::C64_DRIVE_THREAD:      return "Parallel drive emulation";
+            case Opt::C64_SID_THREAD:        return "Parallel audio synthesis";
+            case Opt::C64_SLICES:            return "Execution slices per frame";
+            case Opt::C64_BLOCK_EXEC:        return "Block-wise cycle execution";
 
             case Opt::DASM_NUMBERS:          return "Disassembler number format";
                 
@@ -478,6 +512,9 @@ struct OptEnum : Reflectable<OptEnum, Opt> {
             case Opt::DAT_MODEL:             return "Datasette model";
             case Opt::DAT_CONNECT:           return "Datasette connected";
 
+            case Opt::VDR_ENABLE:            return "Virtual drive mode";
+            case Opt::VDR_FALLBACK:          return "Fall back to drive emulation";
+
             case Opt::MOUSE_MODEL:           return "Mouse model";
             case Opt::MOUSE_SHAKE_DETECT:    return "Detect a shaked mouse";
             case Opt::MOUSE_VELOCITY:        return "Mouse velocity";
@@ -497,6 +534,11 @@ struct OptEnum : Reflectable<OptEnum, Opt> {
             case Opt::SRV_TRANSPORT:         return "Server transport protocol";
             case Opt::SRV_VERBOSE:           return "Verbose mode";
 
+            case Opt::REW_BUDGET:            return "Rewind buffer size in MB";
+
+            case Opt::TRC_DRIVES:            return "Trace drive CPUs";
+            case Opt::TRC_SIZE:              return "Trace file size in MB";
+
             case Opt::DBG_DEBUGCART:         return "VICE debug cartridge";
             case Opt::DBG_WATCHDOG:          return "Watchdog delay in cycles";
 
@@ -0,0 +1,78 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#include "vcconfig.h"
+#include "SnapshotWorker.h"
+#include "MsgQueue.h"
+
+namespace vc64 {
+
+SnapshotWorker::~SnapshotWorker()
+{
+    {   std::lock_guard<std::mutex> lock(jobMutex);
+        quit = true;
+    }
+    jobCond.notify_one();
+
+    // Let the worker finish all pending jobs
+    if (thread.joinable()) thread.join();
+}
+
+void
+SnapshotWorker::put(Snapshot *snapshot, Compressor compressor)
+{
+    {   std::lock_guard<std::mutex> lock(jobMutex);
+
+        jobs.push_back(Job { .snapshot = snapshot, .compressor = compressor });
+
+        // Launch the worker thread if it isn't running yet
+        if (!thread.joinable()) thread = std::thread(&SnapshotWorker::main, this);
+    }
+    jobCond.notify_one();
+}
+
+void
+SnapshotWorker::main()
+{
+    loginfo(SNP_DEBUG, "Snapshot worker launched\n");
+
+    while (true) {
+
+        Job job;
+
+        {   std::unique_lock<std::mutex> lock(jobMutex);
+
+            jobCond.wait(lock, [this]() { return quit || !jobs.empty(); });
+            if (jobs.empty()) break;
+
+            job = jobs.front();
+            jobs.pop_front();
+        }
+
+        try {
+
+            job.snapshot->compress(job.compressor);
+
+        } catch (std::exception &e) {
+
+            // Hand over the snapshot uncompressed
+            logwarn("Failed to compress snapshot: %s\n", e.what());
+        }
+
+        // Hand the snapshot over to the GUI
+        msgQueue.put( Message { .type = Msg::SNAPSHOT_TAKEN, .snapshot = { job.snapshot } } );
+    }
+
+    loginfo(SNP_DEBUG, "Snapshot worker terminated\n");
+}
+
+}
@@ -0,0 +1,84 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreObject.h"
+#include "Snapshot.h"
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace vc64 {
+
+class MsgQueue;
+
+/* The snapshot worker compresses snapshots in the background. The emulator
+ * thread only serializes the machine state and hands the uncompressed
+ * snapshot over to the worker. When compression has finished, the worker
+ * passes the snapshot to the GUI via a SNAPSHOT_TAKEN message. The worker
+ * thread is launched on demand when the first job arrives.
+ */
+class SnapshotWorker final : public CoreObject {
+
+    // A pending compression job
+    struct Job {
+
+        Snapshot *snapshot;
+        Compressor compressor;
+    };
+
+    // Destination of the SNAPSHOT_TAKEN messages
+    MsgQueue &msgQueue;
+
+    // The worker thread
+    std::thread thread;
+
+    // Pending jobs
+    std::deque<Job> jobs;
+
+    // Synchronization primitives
+    std::mutex jobMutex;
+    std::condition_variable jobCond;
+
+    // Indicates if the worker thread should terminate
+    bool quit = false;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    SnapshotWorker(MsgQueue &msgQueue) : msgQueue(msgQueue) { }
+    ~SnapshotWorker();
+
+    const char *objectName() const override { return "SnapshotWorker"; }
+
+
+    //
+    // Compressing snapshots
+    //
+
+public:
+
+    // Schedules an uncompressed snapshot for compression (takes ownership)
+    void put(Snapshot *snapshot, Compressor compressor);
+
+private:
+
+    // The main thread function
+    void main();
+};
+
+}
@@ -39,6 +39,8 @@ msgQueue(ref.msgQueue),
 parCable(ref.parCable),
 powerSupply(ref.supply),
 regressionTester(ref.regressionTester),
+rewindBuffer(ref.rewindBuffer),
+tracer(ref.tracer),
 remoteManager(ref.remoteManager),
 retroShell(ref.retroShell),
 sidBridge(ref.sidBridge),
@@ -47,7 +49,8 @@ sid1(ref.sidBridge.sid[1]),
 sid2(ref.sidBridge.sid[2]),
 sid3(ref.sidBridge.sid[3]),
 vic(ref.vic),
-videoPort(ref.videoPort)
+videoPort(ref.videoPort),
+vdrive(ref.vdrive)
 {
 
 };
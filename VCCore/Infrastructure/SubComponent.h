@@ -41,6 +41,8 @@ public:
     class ParCable &parCable;
     class PowerPort &powerSupply;
     class RegressionTester &regressionTester;
+    class RewindBuffer &rewindBuffer;
+    class Tracer &tracer;
     class RemoteManager &remoteManager;
     class RetroShell &retroShell;
     class SIDBridge &sidBridge;
@@ -50,6 +52,7 @@ public:
     class SID& sid3;
     class VICII &vic;
     class VideoPort &videoPort;
+    class VirtualDrive &vdrive;
 
     Drive *drive[2] = { &drive8, &drive9 };
 
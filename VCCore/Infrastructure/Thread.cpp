@@ -47,10 +47,10 @@ Thread::execute()
     // Only proceed if the emulator is running
     if (!isRunning()) return;
 
-    // Determine the number of overdue frames
+    // Determine the number of overdue frames (or time slices)
     isize missing = warp ? 1 : missingFrames();
 
-    if (std::abs(missing) <= 5) {
+    if (std::abs(missing) <= 5 * slicesPerFrame()) {
 
         lock.lock();
         loadClock.go();
@@ -58,9 +58,9 @@ Thread::execute()
         try {
 
             // Execute all missing frames
-            for (isize i = 0; i < missing; i++, frameCounter++) {
+            for (isize i = 0; i < missing; i++, frameCounter++, sliceCounter++) {
 
-                // Execute a single frame
+                // Execute a single frame (or time slice)
                 computeFrame();
             }
 
@@ -107,6 +107,11 @@ Thread::sleep()
     // Set a timeout to prevent the thread from stalling
     auto timeout = utl::Time::milliseconds(50);
 
+    // In slice mode, wake up in time for the next slice
+    if (slicesPerFrame() > 1) {
+        timeout = std::min(timeout, nextSliceTime() - utl::Time::now());
+    }
+
     // Wait for the next pulse
     waitForWakeUp(timeout);
 }
@@ -118,14 +123,23 @@ Thread::computeStats()
 
         auto used  = loadClock.getElapsedTime().asSeconds();
         auto total = nonstopClock.getElapsedTime().asSeconds();
+        auto cycle = emulatedCycles();
 
         loadClock.restart();
         loadClock.stop();
         nonstopClock.restart();
 
+        // In slice mode, derive the frame rate from the computed slices
+        auto slices = slicesPerFrame();
+        auto frames = slices > 1 ? double(sliceCounter) / double(slices) : double(statsCounter);
+
         cpuLoad = 0.3 * cpuLoad + 0.7 * used / total;
-        fps = 0.3 * fps + 0.7 * statsCounter / total;
+        fps = 0.3 * fps + 0.7 * frames / total;
+        cps = 0.3 * cps + 0.7 * std::max(i64(0), cycle - lastCycle) / total;
+
+        lastCycle = cycle;
 
+        sliceCounter = 0;
         statsCounter = 0;
     }
 }
@@ -58,6 +58,7 @@ protected:
     // Counters
     mutable isize suspendCounter = 0;
     isize frameCounter = 0;
+    isize sliceCounter = 0;
     isize statsCounter = 0;
 
     // Time stamps
@@ -72,6 +73,10 @@ protected:
     double fps = 0.0;
     isize resyncs = 0;
 
+    // Emulated cycles per second
+    double cps = 0.0;
+    i64 lastCycle = 0;
+
     // Debug clocks
     utl::Clock wakeupClock;
 
@@ -120,9 +125,22 @@ private:
     // Computes the number of overdue frames (provided by the subclass)
     virtual isize missingFrames() const = 0;
 
+    /* Returns the number of time slices per frame (provided by the subclass).
+     * If the value is greater than 1, the thread advances the emulator in
+     * fractions of a frame. In this case, frameCounter counts time slices and
+     * computeFrame() is expected to compute a single slice.
+     */
+    virtual isize slicesPerFrame() const = 0;
+
+    // Returns the point in time when the next time slice is due
+    virtual utl::Time nextSliceTime() const = 0;
+
     // The code to be executed in each iteration (implemented by the subclass)
     virtual void computeFrame() = 0;
 
+    // Returns the number of emulated CPU cycles (provided by the subclass)
+    virtual i64 emulatedCycles() const = 0;
+
     // Rectifies an out-of-sync condition. Resets all counters and clocks.
     void resync();
 
@@ -254,6 +254,28 @@ Cartridge::cloneRomAndRam(const Cartridge& other)
     }
 }
 
+void
+Cartridge::syncRamWith(Cartridge &other)
+{
+    if (!externalRam || ramCapacity != other.ramCapacity) return;
+
+    // Copy all pages that have been modified in either instance
+    auto pages = dirtyRam;
+    pages |= other.dirtyRam;
+    pages.forEach([&](isize nr) {
+
+        auto offset = nr << 12;
+        auto count = std::min(isize(4096), ramCapacity - offset);
+        memcpy(externalRam + offset, other.externalRam + offset, count);
+    });
+
+    dirtyRam.clear();
+    other.dirtyRam.clear();
+
+    // Let cloneRomAndRam() know that both RAMs are in sync
+    writes = other.writes;
+}
+
 void 
 Cartridge::cacheInfo(CartridgeInfo &result) const
 {
@@ -400,6 +422,7 @@ Cartridge::pokeRAM(u32 addr, u8 value)
 {
     assert(isize(addr) < ramCapacity);
     externalRam[addr] = value;
+    dirtyRam.mark(addr >> 12);
     writes++;
 }
 
@@ -409,6 +432,7 @@ Cartridge::eraseRAM(u8 value)
     if (externalRam) {
      
         memset(externalRam, value, ramCapacity);
+        dirtyRam.markAll();
         writes += ramCapacity;
     }
 }
@@ -15,6 +15,7 @@
 #include "CartridgeTypes.h"
 #include "SubComponent.h"
 #include "CartridgeRom.h"
+#include "DirtyPages.h"
 #include "CRTFile.h"
 #include "utl/types/Literals.h"
 
@@ -110,6 +111,9 @@ private:
     // Total number of write accesses
     i64 writes = 0;
 
+    // Modified RAM pages (4KB each, used to synchronize the run-ahead instance)
+    DirtyPages<4096> dirtyRam;
+
 
     //
     // On-board registers
@@ -199,6 +203,9 @@ public:
     void cloneRomAndRam(const Cartridge& other);
     virtual void clone(const Cartridge &other) { *this = other; }
 
+    // Copies all RAM pages that differ from another cartridge
+    void syncRamWith(Cartridge &other);
+
 
     //
     // Methods from Serializable
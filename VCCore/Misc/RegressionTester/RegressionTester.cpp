@@ -115,6 +115,8 @@ void
 RegressionTester::processEvent(EventID id)
 {
     loginfo(STDERR, "Watchdog triggerd: Shutting down the emulator\n");
+    c64.cancel<SLOT_DBG>();
+    watchdogExpired = true;
     msgQueue.put(Msg::ABORT, 1);
 }
 
@@ -133,6 +135,8 @@ RegressionTester::pokeDebugCart(u16 addr, u8 value)
 void 
 RegressionTester::setWatchdog(Cycle cycle)
 {
+    watchdogExpired = false;
+
     if (cycle == 0) {
 
         // Disable the watchdog
@@ -55,6 +55,9 @@ public:
     isize x2 = X2;
     isize y2 = Y2;
 
+    // Indicates if the watchdog timer has fired
+    bool watchdogExpired = false;
+
 private:
 
     // When the emulator exits, this value is returned to the test script
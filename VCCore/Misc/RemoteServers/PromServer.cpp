@@ -104,6 +104,14 @@ PromServer::didReceive(const httplib::Request &req, httplib::Response &res)
                   "gauge", std::to_string(stats.fps),
                   {{"component","emulator"}});
 
+        translate("vc64_cycles_per_second", "Emulated CPU cycles per second",
+                  "gauge", std::to_string(stats.cps),
+                  {{"component","emulator"}});
+
+        translate("vc64_speedup", "Emulation speed relative to a real C64",
+                  "gauge", std::to_string(stats.speedup),
+                  {{"component","emulator"}});
+
         translate("vc64_resyncs", "",
                   "gauge", std::to_string(stats.resyncs),
                   {{"component","emulator"}});
@@ -156,6 +164,24 @@ PromServer::didReceive(const httplib::Request &req, httplib::Response &res)
         translate("vc64_audio_fill_level", "",
                   "gauge", std::to_string(stats.fillLevel),
                   {{"component","audio"}});
+
+        for (isize i = 0; i < AudioStream::latencyBuckets; i++) {
+
+            translate("vc64_audio_latency", "",
+                      "gauge", std::to_string(stats.latency[i]),
+                      {{"component","audio"},{"ms",std::to_string(i * AudioStream::latencyBucketWidth)}});
+        }
+    }
+
+    {   translate("vc64_messages", "",
+                  "counter", std::to_string(msgQueue.getDispatched()),
+                  {{"component","msgqueue"},{"type","dispatched"}});
+        translate("vc64_messages", "",
+                  "counter", std::to_string(msgQueue.getCoalesced()),
+                  {{"component","msgqueue"},{"type","coalesced"}});
+        translate("vc64_messages", "",
+                  "counter", std::to_string(msgQueue.getDropped()),
+                  {{"component","msgqueue"},{"type","dropped"}});
     }
 
     res.set_content(output.str(), "text/plain");
@@ -15,6 +15,7 @@
 #include "Emulator.h"
 #include "json.h"
 #include "httplib.h"
+#include <cstring>
 #include <thread>
 
 namespace vc64 {
@@ -79,7 +80,7 @@ void
 RpcServer::didReceive(const string &payload)
 {
     if (auto response = process(payload); response) {
-        tcp << *response;
+        *this << *response;
     }
 }
 
@@ -94,52 +95,145 @@ RpcServer::didReceive(const struct httplib::Request &req, struct httplib::Respon
 optional<string>
 RpcServer::process(const string &payload, bool blocking)
 {
+    json request;
+
     try {
 
-        json request = json::parse(payload);
+        request = json::parse(payload);
+
+    } catch (const json::parse_error &) {
+
+        json response = {
+
+            {"jsonrpc", "2.0"},
+            {"error", {{"code", RPC::PARSE_ERROR}, {"message", "Parse error: " + payload}}},
+            {"id", nullptr}
+        };
+        return response.dump();
+    }
+
+    bool batch = request.is_array();
+
+    if (batch && request.empty()) {
+
+        json response = {
+
+            {"jsonrpc", "2.0"},
+            {"error", {{"code", RPC::INVALID_REQUEST}, {"message", "Empty batch"}}},
+            {"id", nullptr}
+        };
+        return response.dump();
+    }
+
+    json requests = batch ? request : json::array({ request });
+    json responses = json::array();
+
+    {   std::lock_guard<std::mutex> guard(mutex);
+
+        /* Structured methods are executed right here with the emulator thread
+         * being suspended. To keep the overhead low, the emulator stays
+         * suspended until the batch has been processed. It is only resumed
+         * for RetroShell commands, because these are executed by the emulator
+         * thread. Inside a batch, RetroShell commands are always executed in
+         * blocking mode to collect all responses in a single array.
+         */
+        bool suspended = false;
+
+        for (auto &it : requests) {
+
+            bool shell = it.is_object() && it.value("method", json()) == "retroshell";
+
+            if (shell && suspended) { emulator.resume(); suspended = false; }
+            if (!shell && !suspended) { emulator.suspend(); suspended = true; }
+
+            if (auto response = dispatch(it, blocking || batch); response) {
+                responses.push_back(*response);
+            }
+        }
+
+        if (suspended) emulator.resume();
+    }
+
+    // Notifications don't produce a response
+    if (responses.empty()) return {};
+
+    return batch ? responses.dump() : responses[0].dump();
+}
+
+optional<json>
+RpcServer::dispatch(const json &request, bool blocking)
+{
+    json id = request.is_object() ? request.value("id", json()) : json();
+
+    auto error = [&](i64 code, const string &message) {
+
+        return json {
+
+            {"jsonrpc", "2.0"},
+            {"error", {{"code", code}, {"message", message}}},
+            {"id", id}
+        };
+    };
+
+    try {
 
         // Check input format
+        if (!request.is_object()) {
+            throw AppException(RPC::INVALID_REQUEST, "Request must be an object");
+        }
         if (!request.contains("method")) {
             throw AppException(RPC::INVALID_REQUEST, "Missing 'method'");
         }
-        if (!request.contains("params")) {
-            throw AppException(RPC::INVALID_REQUEST, "Missing 'params'");
-        }
         if (!request["method"].is_string()) {
             throw AppException(RPC::INVALID_PARAMS, "'method' must be a string");
         }
-        if (!request["params"].is_string()) {
-            throw AppException(RPC::INVALID_PARAMS, "'params' must be a string");
-        }
-        if (request["method"] != "retroshell") {
-            throw AppException(RPC::INVALID_PARAMS, "method  must be 'retroshell'");
+
+        if (request["method"] == "retroshell") {
+
+            if (!request.contains("params")) {
+                throw AppException(RPC::INVALID_REQUEST, "Missing 'params'");
+            }
+            if (!request["params"].is_string()) {
+                throw AppException(RPC::INVALID_PARAMS, "'params' must be a string");
+            }
+
+            isize nr = id.is_number_integer() ? id.get<isize>() : 0;
+
+            if (blocking) {
+                return json::parse(*execBlocking(request["params"], nr));
+            }
+            execNonBlocking(request["params"], nr);
+            return {};
         }
 
-        if (blocking) {
-            return execBlocking(request["params"], request.value("id", 0));
-        } else {
-            return execNonBlocking(request["params"], request.value("id", 0));
+        auto params = request.value("params", json::object());
+        if (!params.is_object()) {
+            throw AppException(RPC::INVALID_PARAMS, "'params' must be an object");
         }
 
-    } catch (const json::parse_error &) {
+        auto result = exec(request["method"], params);
 
-        json response = {
+        // Don't respond to notifications
+        if (!request.contains("id")) return {};
+
+        return json {
 
             {"jsonrpc", "2.0"},
-            {"error", {{"code", RPC::PARSE_ERROR}, {"message", "Parse error: " + payload}}},
-            {"id", nullptr}
+            {"result", result},
+            {"id", id}
         };
-        return response.dump();
 
     } catch (const AppException &e) {
 
-        json response = {
+        return error(e.data, e.what());
 
-            {"jsonrpc", "2.0"},
-            {"error", {{"code", e.data}, {"message", e.what()}}},
-            {"id", nullptr}
-        };
-        return response.dump();
+    } catch (const json::exception &e) {
+
+        return error(RPC::INVALID_PARAMS, e.what());
+
+    } catch (const std::exception &e) {
+
+        return error(RPC::INTERNAL_ERROR, e.what());
     }
 }
 
@@ -189,10 +283,12 @@ RpcServer::didExecute(const InputLine& input, std::stringstream &ss)
         {"id", input.id}
     };
 
-    // If a promise is attached, fulfill it
-    if (input.promise) { input.promise->set_value(response.dump()); }
-
-    *this << response.dump();
+    // If a promise is attached, fulfill it. Otherwise, send the response
+    if (input.promise) {
+        input.promise->set_value(response.dump());
+    } else {
+        *this << response.dump();
+    }
 }
 
 void
@@ -223,10 +319,326 @@ RpcServer::didExecute(const InputLine& input, std::stringstream &ss, std::except
         {"id", input.id}
     };
 
-    // If a promise is attached, fulfill it
-    if (input.promise) { input.promise->set_value(response.dump()); }
+    // If a promise is attached, fulfill it. Otherwise, send the response
+    if (input.promise) {
+        input.promise->set_value(response.dump());
+    } else {
+        *this << response.dump();
+    }
+}
+
+//
+// Structured methods
+//
+
+static const char *base64 =
+"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static string
+encodeBase64(const u8 *data, isize len)
+{
+    string result;
+    result.reserve(4 * ((len + 2) / 3));
+
+    for (isize i = 0; i < len; i += 3) {
+
+        u32 bits = u32(data[i]) << 16;
+        if (i + 1 < len) bits |= u32(data[i + 1]) << 8;
+        if (i + 2 < len) bits |= u32(data[i + 2]);
+
+        result += base64[(bits >> 18) & 0x3F];
+        result += base64[(bits >> 12) & 0x3F];
+        result += i + 1 < len ? base64[(bits >> 6) & 0x3F] : '=';
+        result += i + 2 < len ? base64[bits & 0x3F] : '=';
+    }
+    return result;
+}
+
+static std::vector<u8>
+decodeBase64(const string &s)
+{
+    std::vector<u8> result;
+    result.reserve(3 * s.size() / 4);
+
+    u32 bits = 0;
+    isize count = 0;
+
+    for (auto c : s) {
+
+        if (c == '=') break;
+
+        auto pos = std::strchr(base64, c);
+        if (!pos || c == 0) throw AppException(RPC::INVALID_PARAMS, "Invalid base64 data");
+
+        bits = bits << 6 | u32(pos - base64);
+        if ((count += 6) >= 8) { count -= 8; result.push_back(u8(bits >> count)); }
+    }
+    return result;
+}
+
+static i64
+intParam(const json &params, const char *key, i64 min, i64 max)
+{
+    if (!params.contains(key)) {
+        throw AppException(RPC::INVALID_PARAMS, "Missing '" + string(key) + "'");
+    }
+    if (!params[key].is_number_integer()) {
+        throw AppException(RPC::INVALID_PARAMS, "'" + string(key) + "' must be an integer");
+    }
+    auto value = params[key].get<i64>();
+    if (value < min || value > max) {
+        throw AppException(RPC::INVALID_PARAMS, "'" + string(key) + "' is out of range");
+    }
+    return value;
+}
+
+static i64
+intParam(const json &params, const char *key, i64 min, i64 max, i64 fallback)
+{
+    return params.contains(key) ? intParam(params, key, min, max) : fallback;
+}
+
+static bool
+boolParam(const json &params, const char *key, bool fallback)
+{
+    if (!params.contains(key)) return fallback;
+
+    if (!params[key].is_boolean()) {
+        throw AppException(RPC::INVALID_PARAMS, "'" + string(key) + "' must be a boolean");
+    }
+    return params[key].get<bool>();
+}
+
+static string
+stringParam(const json &params, const char *key, const string &fallback)
+{
+    if (!params.contains(key)) return fallback;
+
+    if (!params[key].is_string()) {
+        throw AppException(RPC::INVALID_PARAMS, "'" + string(key) + "' must be a string");
+    }
+    return params[key].get<string>();
+}
+
+json
+RpcServer::exec(const string &method, const json &params)
+{
+    assert(emulator.isSuspended());
+
+    if (method == "mem.read")           return execMemRead(params);
+    if (method == "mem.write")          return execMemWrite(params);
+    if (method == "c64.run")            return execRun(params);
+    if (method == "video.texture")      return execTexture(params);
+    if (method == "input.joystick")     return execJoystick(params);
+    if (method == "input.keyboard")     return execKeyboard(params);
+    if (method == "snapshot.take")      return execTakeSnapshot(params);
+    if (method == "snapshot.restore")   return execRestoreSnapshot(params);
+    if (method == "snapshot.delete")    return execDeleteSnapshot(params);
+
+    throw AppException(RPC::METHOD_NOT_FOUND, "Unknown method '" + method + "'");
+}
+
+json
+RpcServer::execMemRead(const json &params)
+{
+    auto addr = intParam(params, "addr", 0, 0xFFFF);
+    auto len = intParam(params, "length", 1, 0x10000 - addr);
+    auto source = stringParam(params, "source", "cpu");
+
+    std::vector<u8> buffer(len);
+
+    if (source == "cpu") {
+        for (isize i = 0; i < len; i++) buffer[i] = mem.spypeek(u16(addr + i));
+    } else if (source == "ram") {
+        std::memcpy(buffer.data(), mem.ram + addr, len);
+    } else {
+        throw AppException(RPC::INVALID_PARAMS, "'source' must be 'cpu' or 'ram'");
+    }
+
+    return json { {"addr", addr}, {"data", encodeBase64(buffer.data(), len)} };
+}
+
+json
+RpcServer::execMemWrite(const json &params)
+{
+    auto addr = intParam(params, "addr", 0, 0xFFFF);
+    auto data = decodeBase64(stringParam(params, "data", ""));
+    auto target = stringParam(params, "target", "cpu");
+    auto len = isize(data.size());
+
+    if (addr + len > 0x10000) {
+        throw AppException(RPC::INVALID_PARAMS, "Data exceeds the address space");
+    }
+
+    if (target == "cpu") {
+        for (isize i = 0; i < len; i++) mem.poke(u16(addr + i), data[i]);
+    } else if (target == "ram") {
+        std::memcpy(mem.ram + addr, data.data(), len);
+    } else {
+        throw AppException(RPC::INVALID_PARAMS, "'target' must be 'cpu' or 'ram'");
+    }
+
+    emulator.markAsDirty();
+    return json { {"written", len} };
+}
+
+json
+RpcServer::execRun(const json &params)
+{
+    auto frames = intParam(params, "frames", 0, INT32_MAX, 0);
+    auto cycles = intParam(params, "cycles", 0, INT64_MAX, 0);
+
+    if (emulator.isPoweredOff()) {
+        throw AppException(RPC::SERVER_ERROR, "The emulator is powered off");
+    }
+
+    bool interrupted = false;
+
+    try {
+
+        if (frames) c64.fastForward(frames);
+        if (cycles) c64.fastForwardCycles(cycles);
+
+    } catch (const StateChangeException &) {
+
+        // A breakpoint or watchpoint has been hit
+        interrupted = true;
+    }
+
+    emulator.markAsDirty();
+
+    return json {
+
+        {"frame", c64.frame},
+        {"cycle", cpu.clock},
+        {"interrupted", interrupted}
+    };
+}
+
+json
+RpcServer::execTexture(const json &params)
+{
+    auto &tex = videoPort.acquireTexture(0, TEX_CONSUMER_RPC);
 
-    *this << response.dump();
+    // Texels are stored as 0xAABBGGRR which is RGBA in byte order
+    json result = {
+
+        {"width", Texture::width},
+        {"height", Texture::height},
+        {"frame", tex.nr},
+        {"format", "RGBA"},
+        {"data", encodeBase64((const u8 *)tex.pixels.ptr, Texture::texels * sizeof(Texel))}
+    };
+
+    videoPort.releaseTexture(TEX_CONSUMER_RPC);
+    return result;
+}
+
+json
+RpcServer::execJoystick(const json &params)
+{
+    auto &port = intParam(params, "port", 1, 2) == 1 ? port1 : port2;
+    auto &joy = port.joystick;
+
+    if (params.contains("x")) {
+
+        auto x = intParam(params, "x", -1, 1);
+        joy.trigger(x < 0 ? GamePadAction::PULL_LEFT : x > 0 ? GamePadAction::PULL_RIGHT : GamePadAction::RELEASE_X);
+    }
+    if (params.contains("y")) {
+
+        auto y = intParam(params, "y", -1, 1);
+        joy.trigger(y < 0 ? GamePadAction::PULL_UP : y > 0 ? GamePadAction::PULL_DOWN : GamePadAction::RELEASE_Y);
+    }
+    if (params.contains("fire")) {
+
+        auto fire = boolParam(params, "fire", false);
+        joy.trigger(fire ? GamePadAction::PRESS_FIRE : GamePadAction::RELEASE_FIRE);
+    }
+
+    emulator.markAsDirty();
+    return json::object();
+}
+
+json
+RpcServer::execKeyboard(const json &params)
+{
+    auto keys = [&](const char *key) {
+
+        std::vector<C64Key> result;
+
+        if (params.contains(key)) {
+
+            if (!params[key].is_array()) {
+                throw AppException(RPC::INVALID_PARAMS, "'" + string(key) + "' must be an array");
+            }
+            for (auto &it : params[key]) {
+                result.push_back(C64Key(intParam(json { {key, it} }, key, 0, 65)));
+            }
+        }
+        return result;
+    };
+
+    // Check all parameters before modifying the keyboard matrix
+    auto release = keys("release");
+    auto press = keys("press");
+
+    if (boolParam(params, "releaseAll", false)) keyboard.releaseAll();
+    for (auto &key : release) keyboard.release(key);
+    for (auto &key : press) keyboard.press(key);
+
+    emulator.markAsDirty();
+    return json::object();
+}
+
+json
+RpcServer::execTakeSnapshot(const json &params)
+{
+    auto snapshot = c64.takeSnapshotNew(Compressor::NONE);
+
+    // Return the snapshot data if requested
+    if (boolParam(params, "inline", false)) {
+
+        return json {
+
+            {"size", snapshot->getSize()},
+            {"data", encodeBase64(snapshot->getData(), snapshot->getSize())}
+        };
+    }
+
+    // Otherwise, keep the snapshot and return a handle
+    snapshots[++snapshotId] = std::move(snapshot);
+    return json { {"id", snapshotId} };
+}
+
+json
+RpcServer::execRestoreSnapshot(const json &params)
+{
+    if (params.contains("data")) {
+
+        auto data = decodeBase64(stringParam(params, "data", ""));
+        c64.loadSnapshot(Snapshot(data.data(), isize(data.size())));
+
+    } else {
+
+        auto it = snapshots.find(intParam(params, "id", 1, snapshotId));
+        if (it == snapshots.end()) {
+            throw AppException(RPC::INVALID_PARAMS, "Unknown snapshot");
+        }
+        c64.loadSnapshot(*it->second);
+    }
+
+    emulator.markAsDirty();
+    return json::object();
+}
+
+json
+RpcServer::execDeleteSnapshot(const json &params)
+{
+    if (!snapshots.erase(intParam(params, "id", 1, snapshotId))) {
+        throw AppException(RPC::INVALID_PARAMS, "Unknown snapshot");
+    }
+    return json::object();
 }
 
 }
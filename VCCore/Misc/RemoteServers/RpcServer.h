@@ -17,6 +17,9 @@
 #include "StdioTransport.h"
 #include "TcpTransport.h"
 #include "HttpTransport.h"
+#include "Snapshot.h"
+#include "json.h"
+#include <unordered_map>
 
 namespace vc64 {
 
@@ -37,6 +40,13 @@ class RpcServer final : public RemoteServer, public ConsoleDelegate, public Tran
     TcpTransport tcp = TcpTransport(*this);
     HttpTransport http = HttpTransport(*this);
 
+    // Serializes the execution of structured requests
+    std::mutex mutex;
+
+    // Snapshots taken via 'snapshot.take'
+    std::unordered_map<isize, std::unique_ptr<Snapshot>> snapshots;
+    isize snapshotId = 0;
+
 
     //
     // Methods
@@ -99,14 +109,47 @@ protected:
 
 private:
 
-    // Processes a received command
+    // Processes a received command or a batch of commands
     optional<string> process(const string &payload, bool blocking = false);
 
+    // Processes a single request object
+    optional<nlohmann::json> dispatch(const nlohmann::json &request, bool blocking);
+
     // Executes a RetroShell command asynchroneously (non blocking)
     optional<string> execNonBlocking(const string &command, isize id);
 
     // Executes a RetroShell command synchroneously (blocking)
     optional<string> execBlocking(const string &command, isize id);
+
+
+    //
+    // Executing structured methods (emulator must be suspended)
+    //
+
+    /* Executes a method other than 'retroshell'. Binary data (memory ranges,
+     * textures, snapshots) is transferred as base64 encoded strings.
+     *
+     *   mem.read          { addr, length, [source: "cpu" | "ram"] }
+     *   mem.write         { addr, data, [target: "cpu" | "ram"] }
+     *   c64.run           { [frames], [cycles] }
+     *   video.texture     { }
+     *   input.joystick    { port, [x], [y], [fire] }
+     *   input.keyboard    { [press], [release], [releaseAll] }
+     *   snapshot.take     { [inline] }
+     *   snapshot.restore  { id } or { data }
+     *   snapshot.delete   { id }
+     */
+    nlohmann::json exec(const string &method, const nlohmann::json &params);
+
+    nlohmann::json execMemRead(const nlohmann::json &params);
+    nlohmann::json execMemWrite(const nlohmann::json &params);
+    nlohmann::json execRun(const nlohmann::json &params);
+    nlohmann::json execTexture(const nlohmann::json &params);
+    nlohmann::json execJoystick(const nlohmann::json &params);
+    nlohmann::json execKeyboard(const nlohmann::json &params);
+    nlohmann::json execTakeSnapshot(const nlohmann::json &params);
+    nlohmann::json execRestoreSnapshot(const nlohmann::json &params);
+    nlohmann::json execDeleteSnapshot(const nlohmann::json &params);
 };
 
 }
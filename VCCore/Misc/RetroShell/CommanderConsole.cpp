@@ -213,6 +213,117 @@ CommanderConsole::initCommands(RSCommand &root)
     });
 
 
+    //
+    // Rewind buffer
+    //
+
+    RSCommand::currentGroup = "Time travel";
+
+    cmd = registerComponent(rewindBuffer);
+
+    root.add({
+
+        .tokens = { cmd, "frames" },
+        .chelp  = { "Travels back a number of frames" },
+        .args   = { { .name = { "count", "Number of frames" } } },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            emulator.put(Cmd::REWIND, parseNum(args.at("count")));
+        }
+    });
+
+    root.add({
+
+        .tokens = { cmd, "seconds" },
+        .chelp  = { "Travels back a number of seconds" },
+        .args   = { { .name = { "count", "Number of seconds" } } },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            emulator.put(Cmd::REWIND, i64(parseNum(args.at("count")) * c64.refreshRate()));
+        }
+    });
+
+    root.add({
+
+        .tokens = { cmd, "clear" },
+        .chelp  = { "Deletes all recorded frames" },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            rewindBuffer.clear();
+        }
+    });
+
+
+    //
+    // Tracer
+    //
+
+    cmd = registerComponent(tracer);
+
+    root.add({
+
+        .tokens = { cmd, "start" },
+        .chelp  = { "Streams all executed instructions into a trace file" },
+        .args   = { { .name = { "path", "Trace file" } } },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            tracer.start(host.makeAbsolute(args.at("path")));
+        }
+    });
+
+    root.add({
+
+        .tokens = { cmd, "stop" },
+        .chelp  = { "Stops tracing and closes the trace file" },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            tracer.stop();
+        }
+    });
+
+    root.add({
+
+        .tokens = { cmd, "open" },
+        .chelp  = { "Loads a trace file for inspection" },
+        .args   = { { .name = { "path", "Trace file (default: current trace)" }, .flags = rs::opt } },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            tracer.open(args.contains("path") ? host.makeAbsolute(args.at("path")) : fs::path());
+            os << "Loaded " << tracer.reader.count() << " instructions" << std::endl;
+        }
+    });
+
+    root.add({
+
+        .tokens = { cmd, "list" },
+        .chelp  = { "Disassembles instructions from the loaded trace" },
+        .args   = {
+            { .name = { "nr", "First instruction (default: the most recent ones)" }, .flags = rs::opt },
+            { .name = { "count", "Number of instructions" }, .flags = rs::opt }
+        },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            auto count = parseNum(args, "count", 16);
+            auto first = parseNum(args, "nr", tracer.reader.count() - count);
+            tracer.list(os, first, count);
+        }
+    });
+
+    root.add({
+
+        .tokens = { cmd, "find" },
+        .chelp  = { "Searches the loaded trace for an instruction address" },
+        .args   = {
+            { .name = { "address", "Instruction address" } },
+            { .name = { "count", "Maximum number of matches" }, .flags = rs::opt }
+        },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            tracer.find(os, u16(parseAddr(args.at("address"))), parseNum(args, "count", 16));
+        }
+    });
+
+
     //
     // Components
     //
@@ -655,6 +766,38 @@ CommanderConsole::initCommands(RSCommand &root)
     }
 
 
+    //
+    // Peripherals (Virtual drive)
+    //
+
+    cmd = registerComponent(vdrive);
+
+    root.add({
+
+        .tokens = { cmd, "attach" },
+        .chelp  = { "Attaches a disk to a virtual device" },
+        .args   = {
+            { .name = { "device", "Device number (8 to 11)" } },
+            { .name = { "path", "Disk image, file collection, or directory" } }
+        },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            vdrive.attach(parseNum(args.at("device")), host.makeAbsolute(args.at("path")));
+        }
+    });
+
+    root.add({
+
+        .tokens = { cmd, "detach" },
+        .chelp  = { "Detaches the disk from a virtual device" },
+        .args   = { { .name = { "device", "Device number (8 to 11)" } } },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            vdrive.detach(parseNum(args.at("device")));
+        }
+    });
+
+
     //
     // Peripherals (Datasette)
     //
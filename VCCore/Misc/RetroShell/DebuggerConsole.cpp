@@ -269,6 +269,68 @@ DebuggerConsole::initCommands(RSCommand &root)
     });
 
 
+    //
+    // Profiling
+    //
+
+    root.add({
+
+        .tokens = { "profile" },
+        .ghelp  = { "Profile the CPU" },
+        .chelp  = { "Display the flat profile" },
+        .args   = { { .name = { "count", "Number of entries" }, .flags = rs::opt } },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            os << "Profiler: " << (cpu.profiler.isEnabled() ? "enabled" : "disabled") << std::endl;
+            cpu.profiler.dumpFlat(os, parseNum(args, "count", 16));
+        }
+    });
+
+    root.add({
+
+        .tokens = { "profile", "on" },
+        .chelp  = { "Start recording" },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            cpu.profiler.enable();
+        }
+    });
+
+    root.add({
+
+        .tokens = { "profile", "off" },
+        .chelp  = { "Stop recording" },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            cpu.profiler.disable();
+        }
+    });
+
+    root.add({
+
+        .tokens = { "profile", "clear" },
+        .chelp  = { "Delete all recorded data" },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            cpu.profiler.clear();
+        }
+    });
+
+    root.add({
+
+        .tokens = { "profile", "save" },
+        .chelp  = { "Save the call graph in collapsed stack format" },
+        .args   = { { .name = { "path", "File path" } } },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            auto path = host.makeAbsolute(args.at("path"));
+            std::ofstream file(path);
+            if (!file.is_open()) throw IOError(IOError::FILE_CANT_WRITE, path);
+            cpu.profiler.dumpCollapsed(file);
+        }
+    });
+
+
     //
     // Monitoring
     //
@@ -599,6 +661,38 @@ DebuggerConsole::initCommands(RSCommand &root)
         }
     });
 
+    root.add({
+
+        .tokens = { "?", "thread", "stats" },
+        .chelp  = { "Performance statistics" },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            dump(os, emulator, Category::Stats);
+        }
+    });
+
+    root.add({
+
+        .tokens = { "?", "rewind" },
+        .ghelp  = { "Rewind buffer" },
+        .chelp  = { "Inspect the internal state" },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            dump(os, rewindBuffer, Category::State);
+        }
+    });
+
+    root.add({
+
+        .tokens = { "?", "trace" },
+        .ghelp  = { "Instruction tracer" },
+        .chelp  = { "Inspect the internal state" },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            dump(os, tracer, Category::State);
+        }
+    });
+
 
     //
     // Peripherals
@@ -757,6 +851,16 @@ DebuggerConsole::initCommands(RSCommand &root)
         }
     });
 
+    root.add({
+
+        .tokens = { "?", "vdrive" },
+        .chelp  = { "Virtual Drive" },
+        .func   = [this] (std::ostream &os, const Arguments &args, const std::vector<isize> &values) {
+
+            dump(os, vdrive, Category::State);
+        }
+    });
+
     root.add({
 
         .tokens = { "?", "datasette" },
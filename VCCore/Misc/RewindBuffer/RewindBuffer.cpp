@@ -0,0 +1,202 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#include "vcconfig.h"
+#include "RewindBuffer.h"
+#include "Emulator.h"
+#include "utl/abilities/Compressible.h"
+
+namespace vc64 {
+
+static void
+xorBuffers(std::vector<u8> &dst, const std::vector<u8> &src)
+{
+    assert(dst.size() == src.size());
+    for (usize i = 0; i < dst.size(); i++) dst[i] ^= src[i];
+}
+
+void
+RewindBuffer::endFrame()
+{
+    // Only the primary instance is recorded
+    if (config.budget == 0 || isRunAheadInstance()) return;
+
+    // Serialize the current state
+    state.resize(c64.size());
+    c64.save(state.data());
+
+    // Decide whether a new keyframe is needed
+    bool keyframe =
+    ring.empty() ||
+    ring.front().id > referenceId ||
+    reference.size() != state.size() ||
+    deltas + 1 >= keyframeInterval;
+
+    if (keyframe) {
+
+        std::swap(reference, state);
+        record(reference, true);
+
+    } else {
+
+        xorBuffers(state, reference);
+        record(state, false);
+    }
+}
+
+void
+RewindBuffer::clear()
+{
+    {   SYNCHRONIZED
+
+        ring.clear();
+        keyframes = 0;
+        bytes = 0;
+        referenceId = -1;
+        deltas = 0;
+    }
+}
+
+void
+RewindBuffer::record(std::vector<u8> &data, bool keyframe)
+{
+    packed.clear();
+    utl::Compressible::lz4(data.data(), isize(data.size()), packed);
+
+    {   SYNCHRONIZED
+
+        ring.push_back(Entry {
+
+            .id = nextId++,
+            .keyframe = keyframe,
+            .size = isize(data.size()),
+            .data = packed
+        });
+        bytes += isize(packed.size());
+
+        if (keyframe) {
+
+            referenceId = ring.back().id;
+            keyframes++;
+            deltas = 0;
+
+        } else {
+
+            deltas++;
+        }
+
+        trim();
+    }
+}
+
+void
+RewindBuffer::trim()
+{
+    {   SYNCHRONIZED
+
+        auto budget = config.budget * 1024 * 1024;
+
+        auto pop = [&]() {
+
+            if (ring.front().keyframe) keyframes--;
+            bytes -= isize(ring.front().data.size());
+            ring.pop_front();
+        };
+
+        while (bytes > budget && !ring.empty()) {
+
+            pop();
+
+            // Deltas are worthless without their keyframe
+            while (!ring.empty() && !ring.front().keyframe) pop();
+        }
+    }
+}
+
+void
+RewindBuffer::rewind(isize frames)
+{
+    {   SYNCHRONIZED
+
+        if (ring.empty()) return;
+
+        // Locate the target frame and the corresponding keyframe
+        auto target = isize(ring.size()) - 1 - std::clamp(frames, isize(0), isize(ring.size()) - 1);
+        auto key = target;
+        while (!ring[key].keyframe) { key--; assert(key >= 0); }
+
+        // Uncompress the keyframe unless it is still available
+        if (ring[key].id != referenceId || reference.size() != usize(ring[key].size)) {
+
+            reference.clear();
+            utl::Compressible::unlz4(ring[key].data.data(), isize(ring[key].data.size()), reference, ring[key].size);
+            referenceId = ring[key].id;
+        }
+
+        // Reconstruct the target state
+        if (target == key) {
+
+            state = reference;
+
+        } else {
+
+            state.clear();
+            utl::Compressible::unlz4(ring[target].data.data(), isize(ring[target].data.size()), state, ring[target].size);
+            xorBuffers(state, reference);
+        }
+
+        // Discard all frames that have been recorded after the target frame
+        while (isize(ring.size()) > target + 1) {
+
+            if (ring.back().keyframe) keyframes--;
+            bytes -= isize(ring.back().data.size());
+            ring.pop_back();
+        }
+        deltas = target - key;
+    }
+
+    // Restore the state
+    c64.load(state.data());
+
+    // Inform the GUI
+    msgQueue.put(vic.pal() ? Msg::PAL : Msg::NTSC);
+    msgQueue.put(Msg::SNAPSHOT_RESTORED);
+}
+
+void
+RewindBuffer::processCommand(const Command &cmd)
+{
+    switch (cmd.type) {
+
+        case Cmd::REWIND:
+
+            try {
+
+                rewind(isize(cmd.value));
+
+            } catch (std::exception &) {
+
+                /* The recorded data has been corrupted which means that the
+                 * emulator is in an inconsistent state now. We cannot revert
+                 * to the old state, so we perform a hard reset instead.
+                 */
+                clear();
+                emulator.put(Cmd::HARD_RESET);
+            }
+            break;
+
+        default:
+            fatalError;
+    }
+}
+
+}
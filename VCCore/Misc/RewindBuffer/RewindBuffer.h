@@ -0,0 +1,182 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "RewindBufferTypes.h"
+#include "SubComponent.h"
+#include "CmdQueueTypes.h"
+#include <deque>
+
+namespace vc64 {
+
+/* The rewind buffer records the machine state at the end of each frame. To
+ * keep the memory footprint low, only every n-th frame is stored as a
+ * keyframe containing the complete state. All other frames are stored as the
+ * XOR delta to the preceding keyframe. Because most of the state does not
+ * change within a second, the deltas consist mostly of zeroes and shrink to a
+ * few KB when compressed with LZ4. Since a delta never refers to another
+ * delta, reverting to a recorded frame takes at most two decompression runs,
+ * no matter how far we travel back in time.
+ */
+class RewindBuffer final : public SubComponent, public Inspectable<RewindBufferInfo> {
+
+    Descriptions descriptions = {{
+
+        .name           = "RewindBuffer",
+        .description    = "Rewind Buffer",
+        .shell          = "rewind"
+    }};
+
+    Options options = {
+
+        Opt::REW_BUDGET
+    };
+
+    // Current configuration
+    RewindBufferConfig config = { };
+
+    // Number of frames between two keyframes
+    static constexpr isize keyframeInterval = 50;
+
+    // A single recorded frame
+    struct Entry {
+
+        // Unique identifier
+        i64 id;
+
+        // Indicates if this entry stores the full state or a delta
+        bool keyframe;
+
+        // Size of the uncompressed state
+        isize size;
+
+        // LZ4-compressed state or delta
+        std::vector<u8> data;
+    };
+
+    // Recorded frames (oldest first)
+    std::deque<Entry> ring;
+
+    // Identifier of the next entry
+    i64 nextId = 0;
+
+    // Number of recorded keyframes
+    isize keyframes = 0;
+
+    // Memory occupied by all entries
+    isize bytes = 0;
+
+    // Uncompressed state of the most recent keyframe
+    std::vector<u8> reference;
+
+    // Identifier of the most recent keyframe
+    i64 referenceId = -1;
+
+    // Number of deltas that have been recorded since the most recent keyframe
+    isize deltas = 0;
+
+    // Scratch buffers
+    std::vector<u8> state;
+    std::vector<u8> packed;
+
+
+    //
+    // Methods
+    //
+
+public:
+
+    using SubComponent::SubComponent;
+
+    RewindBuffer& operator= (const RewindBuffer& other) { return *this; }
+
+
+    //
+    // Methods from Serializable
+    //
+
+public:
+
+    template <class T> void serialize(T& worker) { } SERIALIZERS(serialize);
+
+
+    //
+    // Methods from CoreComponent
+    //
+
+public:
+
+    const Descriptions &getDescriptions() const override { return descriptions; }
+
+private:
+
+    void _dump(Category category, std::ostream &os) const override;
+
+
+    //
+    // Methods from Inspectable
+    //
+
+public:
+
+    void cacheInfo(RewindBufferInfo &result) const override;
+
+
+    //
+    // Methods from Configurable
+    //
+
+public:
+
+    const RewindBufferConfig &getConfig() const { return config; }
+    const Options &getOptions() const override { return options; }
+    i64 getOption(Opt opt) const override;
+    void checkOption(Opt opt, i64 value) override;
+    void setOption(Opt opt, i64 value) override;
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    // Records the current machine state (called at the end of each frame)
+    void endFrame();
+
+    // Deletes all recorded frames
+    void clear();
+
+private:
+
+    // Compresses a state or delta and appends it to the ring buffer
+    void record(std::vector<u8> &data, bool keyframe);
+
+    // Deletes the oldest entries until the memory budget is met
+    void trim();
+
+
+    //
+    // Rewinding
+    //
+
+public:
+
+    // Reverts to the state that was recorded the specified number of frames ago
+    void rewind(isize frames);
+
+    // Processes a command from the command queue
+    void processCommand(const Command &cmd);
+};
+
+}
@@ -0,0 +1,101 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#include "vcconfig.h"
+#include "RewindBuffer.h"
+#include "C64.h"
+
+namespace vc64 {
+
+void
+RewindBuffer::_dump(Category category, std::ostream &os) const
+{
+    using namespace utl;
+
+    if (category == Category::Config) {
+
+        dumpConfig(os);
+    }
+
+    if (category == Category::State) {
+
+        auto info = getInfo();
+        auto seconds = double(info.frames) / c64.refreshRate();
+
+        os << tab("Recorded frames");
+        os << dec(info.frames) << " (" << flt(seconds) << " sec)" << std::endl;
+        os << tab("Keyframes");
+        os << dec(info.keyframes) << std::endl;
+        os << tab("Memory usage");
+        os << dec(info.bytes / 1024) << " KB" << std::endl;
+    }
+}
+
+void
+RewindBuffer::cacheInfo(RewindBufferInfo &result) const
+{
+    {   SYNCHRONIZED
+
+        result.frames = isize(ring.size());
+        result.keyframes = keyframes;
+        result.bytes = bytes;
+    }
+}
+
+i64
+RewindBuffer::getOption(Opt option) const
+{
+    switch (option) {
+
+        case Opt::REW_BUDGET:        return (i64)config.budget;
+
+        default:
+            fatalError;
+    }
+}
+
+void
+RewindBuffer::checkOption(Opt opt, i64 value)
+{
+    switch (opt) {
+
+        case Opt::REW_BUDGET:
+
+            if (value < 0 || value > 4096) {
+                throw CoreError(CoreError::OPT_INV_ARG, "0...4096");
+            }
+            return;
+
+        default:
+            throw CoreError(CoreError::OPT_UNSUPPORTED);
+    }
+}
+
+void
+RewindBuffer::setOption(Opt opt, i64 value)
+{
+    checkOption(opt, value);
+
+    switch (opt) {
+
+        case Opt::REW_BUDGET:
+
+            config.budget = (isize)value;
+            config.budget ? trim() : clear();
+            return;
+
+        default:
+            fatalError;
+    }
+}
+
+}
@@ -0,0 +1,45 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+/// @file
+
+#pragma once
+
+#include "BasicTypes.h"
+
+namespace vc64 {
+
+
+//
+// Structures
+//
+
+typedef struct
+{
+    //! Memory budget in MB (0 = rewinding is disabled)
+    isize budget;
+}
+RewindBufferConfig;
+
+typedef struct
+{
+    //! Number of recorded frames
+    isize frames;
+
+    //! Number of recorded keyframes
+    isize keyframes;
+
+    //! Memory occupied by all recorded frames in bytes
+    isize bytes;
+}
+RewindBufferInfo;
+
+}
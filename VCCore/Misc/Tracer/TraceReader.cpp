@@ -0,0 +1,67 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#include "vcconfig.h"
+#include "TraceReader.h"
+#include "utl/io/IOError.h"
+#include <fstream>
+
+namespace vc64 {
+
+void
+TraceReader::open(const fs::path &path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open()) throw IOError(IOError::FILE_NOT_FOUND, path);
+
+    // Read and verify the header
+    TraceHeader h;
+    if (!stream.read((char *)&h, sizeof(h))) throw IOError(IOError::FILE_CANT_READ, path);
+    if (memcmp(h.magic, TRACE_MAGIC, sizeof(h.magic)) != 0 ||
+        h.recordSize != sizeof(TraceRecord) || h.capacity <= 0 || h.count < 0) {
+        throw IOError(IOError::FILE_TYPE_MISMATCH, path);
+    }
+
+    // Read all records
+    std::vector<TraceRecord> ring(usize(std::min(h.count, h.capacity)));
+    auto bytes = std::streamsize(ring.size() * sizeof(TraceRecord));
+    if (!stream.read((char *)ring.data(), bytes)) throw IOError(IOError::FILE_CANT_READ, path);
+
+    // Bring the records into chronological order
+    auto oldest = h.count > h.capacity ? isize(h.count % h.capacity) : 0;
+    std::rotate(ring.begin(), ring.begin() + oldest, ring.end());
+
+    header = h;
+    records = std::move(ring);
+}
+
+isize
+TraceReader::find(u16 pc, isize from) const
+{
+    for (isize i = std::max(from, isize(0)); i < count(); i++) {
+        if (records[i].pc == pc) return i;
+    }
+    return -1;
+}
+
+bool
+TraceReader::isCompatible(const fs::path &path)
+{
+    std::ifstream stream(path, std::ios::binary);
+
+    char magic[8];
+    if (!stream.read(magic, sizeof(magic))) return false;
+
+    return memcmp(magic, TRACE_MAGIC, sizeof(magic)) == 0;
+}
+
+}
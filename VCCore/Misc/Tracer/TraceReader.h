@@ -0,0 +1,60 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "TracerTypes.h"
+#include <vector>
+
+namespace vc64 {
+
+/* The trace reader provides offline access to a trace file written by the
+ * tracer. It has no dependencies on the emulator and can thus be used by
+ * external tools, too. When a file is opened, all records are loaded into
+ * memory in chronological order, i.e., record 0 is the oldest instruction
+ * that is still contained in the file.
+ */
+class TraceReader {
+
+    // File header
+    TraceHeader header = { };
+
+    // Recorded instructions (oldest first)
+    std::vector<TraceRecord> records;
+
+public:
+
+    TraceReader() = default;
+    TraceReader(const fs::path &path) { open(path); }
+
+    // Reads a trace file
+    void open(const fs::path &path);
+
+    // Returns the number of available records
+    isize count() const { return isize(records.size()); }
+
+    // Returns the number of instructions that have been recorded in total
+    i64 total() const { return header.count; }
+
+    // Returns a record (0 = oldest)
+    const TraceRecord &operator[](isize nr) const { return records[nr]; }
+
+    /* Searches the next record with the specified instruction address,
+     * starting at the specified record. Returns -1 if no record is found.
+     */
+    isize find(u16 pc, isize from = 0) const;
+
+    // Checks if a file is a trace file
+    static bool isCompatible(const fs::path &path);
+};
+
+}
@@ -0,0 +1,289 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#include "vcconfig.h"
+#include "Tracer.h"
+#include "Emulator.h"
+#include <iomanip>
+
+#ifdef TRACER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace vc64 {
+
+Tracer::~Tracer()
+{
+    try { stop(); } catch (...) { }
+}
+
+bool
+Tracer::traces(const CPU &cpu) const
+{
+    return isTracing() && (cpu.isC64CPU() || config.drives);
+}
+
+void
+Tracer::start(const fs::path &path)
+{
+    stop();
+
+    // Only the primary instance is traced
+    if (isRunAheadInstance()) return;
+
+    {   SYNCHRONIZED
+
+        header = TraceHeader {
+
+            .recordSize = u32(sizeof(TraceRecord)),
+            .capacity = i64(config.size) * 1024 * 1024 / i64(sizeof(TraceRecord)),
+            .count = 0
+        };
+        memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+
+        auto size = isize(sizeof(TraceHeader)) + isize(header.capacity * sizeof(TraceRecord));
+
+#ifdef TRACER_MMAP
+
+        fd = ::open(path.string().c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) throw IOError(IOError::FILE_CANT_CREATE, path);
+
+        if (ftruncate(fd, off_t(size)) != 0) {
+
+            ::close(fd); fd = -1;
+            throw IOError(IOError::FILE_CANT_WRITE, path);
+        }
+
+        auto *ptr = mmap(nullptr, size_t(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (ptr == MAP_FAILED) {
+
+            ::close(fd); fd = -1;
+            throw IOError(IOError::FILE_CANT_WRITE, path);
+        }
+
+        mapping = (u8 *)ptr;
+        mappingSize = size;
+
+#else
+
+        stream.open(path, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+        if (!stream.is_open()) throw IOError(IOError::FILE_CANT_CREATE, path);
+
+#endif
+
+        this->path = path;
+        buffered = 0;
+        writeHeader();
+    }
+
+    updateLogging();
+}
+
+void
+Tracer::stop()
+{
+    if (!isTracing()) return;
+
+    flush();
+
+    {   SYNCHRONIZED
+
+#ifdef TRACER_MMAP
+
+        munmap(mapping, size_t(mappingSize));
+        ::close(fd);
+        mapping = nullptr;
+        mappingSize = 0;
+        fd = -1;
+
+#else
+
+        stream.close();
+
+#endif
+
+        path.clear();
+    }
+
+    updateLogging();
+}
+
+void
+Tracer::record(const CPU &cpu)
+{
+    if (buffered == bufferCapacity) flush();
+
+    auto &instr = cpu.debugger.logEntryRel(0);
+
+    buffer[buffered++] = TraceRecord {
+
+        .cycle = instr.cycle,
+        .pc = instr.pc,
+        .cpu = u8(cpu.getID()),
+        .bytes = { instr.byte1, instr.byte2, instr.byte3 },
+        .a = instr.a,
+        .x = instr.x,
+        .y = instr.y,
+        .sp = instr.sp,
+        .flags = instr.flags
+    };
+}
+
+void
+Tracer::flush()
+{
+    if (!isTracing() || buffered == 0) return;
+
+    {   SYNCHRONIZED
+
+        // Copy the collected records into the ring buffer (in at most two chunks)
+        for (isize i = 0; i < buffered;) {
+
+            auto pos = isize(header.count % header.capacity);
+            auto chunk = std::min(buffered - i, isize(header.capacity) - pos);
+
+            write(pos, buffer + i, chunk);
+            header.count += chunk;
+            i += chunk;
+        }
+
+        buffered = 0;
+        writeHeader();
+    }
+}
+
+void
+Tracer::updateLogging()
+{
+    for (auto *cpu : { &c64.cpu, &drive8.cpu, &drive9.cpu }) {
+
+        if (traces(*cpu)) {
+
+            cpu->debugger.enableLogging();
+
+        } else if (!(emulator.isTracking() && cpu->isC64CPU())) {
+
+            cpu->debugger.disableLogging();
+        }
+    }
+}
+
+void
+Tracer::write(isize pos, const TraceRecord *records, isize count)
+{
+    auto offset = isize(sizeof(TraceHeader)) + pos * isize(sizeof(TraceRecord));
+    auto bytes = count * isize(sizeof(TraceRecord));
+
+#ifdef TRACER_MMAP
+
+    memcpy(mapping + offset, records, bytes);
+
+#else
+
+    stream.seekp(offset);
+    stream.write((const char *)records, bytes);
+
+#endif
+}
+
+void
+Tracer::writeHeader()
+{
+#ifdef TRACER_MMAP
+
+    memcpy(mapping, &header, sizeof(header));
+
+#else
+
+    stream.seekp(0);
+    stream.write((const char *)&header, sizeof(header));
+    stream.flush();
+
+#endif
+}
+
+void
+Tracer::open(const fs::path &path)
+{
+    if (path.empty()) {
+
+        if (!isTracing()) throw CoreError(CoreError::UNKNOWN, "No trace is being recorded");
+
+        // Make sure the trace file is up to date
+        flush();
+        reader.open(this->path);
+
+    } else {
+
+        reader.open(path);
+    }
+}
+
+peddle::RecordedInstruction
+Tracer::toInstruction(const TraceRecord &record)
+{
+    return peddle::RecordedInstruction {
+
+        .cycle = record.cycle,
+        .byte1 = record.bytes[0],
+        .byte2 = record.bytes[1],
+        .byte3 = record.bytes[2],
+        .pc = record.pc,
+        .sp = record.sp,
+        .a = record.a,
+        .x = record.x,
+        .y = record.y,
+        .flags = record.flags
+    };
+}
+
+void
+Tracer::list(std::ostream &os, isize first, isize count) const
+{
+    char buf[256];
+
+    first = std::max(first, isize(0));
+    auto last = std::min(first + count, reader.count());
+
+    for (isize i = first; i < last; i++) {
+
+        auto &record = reader[i];
+
+        // Use the disassembler of the recording CPU
+        auto &cpu = record.cpu == 2 ? drive9.cpu : record.cpu == 1 ? drive8.cpu : c64.cpu;
+        cpu.disassembler.disass(buf, "%p  %a %x %y %s  %f  %i", toInstruction(record));
+
+        os << std::setfill(' ') << std::right << std::dec;
+        os << std::setw(10) << i << "  ";
+        os << (record.cpu == 0 ? "C64" : record.cpu == 1 ? "DF8" : "DF9") << "  ";
+        os << std::setw(12) << record.cycle << "  ";
+        os << buf << std::endl;
+    }
+}
+
+void
+Tracer::find(std::ostream &os, u16 pc, isize max) const
+{
+    isize found = 0;
+
+    for (isize i = reader.find(pc); i >= 0 && found < max; i = reader.find(pc, i + 1)) {
+
+        list(os, i, 1);
+        found++;
+    }
+
+    if (found == 0) os << "No matching instructions found" << std::endl;
+}
+
+}
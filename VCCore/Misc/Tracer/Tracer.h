@@ -0,0 +1,202 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "TracerTypes.h"
+#include "TraceReader.h"
+#include "SubComponent.h"
+#include "PeddleTypes.h"
+#include <fstream>
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#define TRACER_MMAP
+#endif
+
+namespace vc64 {
+
+/* The tracer streams all executed instructions into a trace file. In contrast
+ * to the log buffer of the CPU debugger, which only keeps the most recent
+ * instructions, the trace file can hold millions of instructions. It is
+ * organized as a ring buffer of fixed-size records following a small header.
+ * If the file is full, the oldest records are overwritten.
+ *
+ * Records are collected in a small buffer first and copied into the trace
+ * file in chunks. On platforms supporting it, the trace file is memory-mapped.
+ * Hence, all records that have been flushed survive a crash of the emulator.
+ * The buffer is flushed at the end of each frame.
+ */
+class Tracer final : public SubComponent, public Inspectable<TracerInfo> {
+
+    Descriptions descriptions = {{
+
+        .name           = "Tracer",
+        .description    = "Instruction Tracer",
+        .shell          = "trace"
+    }};
+
+    Options options = {
+
+        Opt::TRC_DRIVES,
+        Opt::TRC_SIZE
+    };
+
+    // Current configuration
+    TracerConfig config = { };
+
+    // Number of records that are collected before they are written
+    static constexpr isize bufferCapacity = 1024;
+
+    // Collected records
+    TraceRecord buffer[bufferCapacity];
+
+    // Number of collected records
+    isize buffered = 0;
+
+    // Path of the current trace file (empty if tracing is off)
+    fs::path path;
+
+    // Header of the current trace file
+    TraceHeader header = { };
+
+#ifdef TRACER_MMAP
+
+    // File descriptor of the trace file
+    int fd = -1;
+
+    // Memory-mapped trace file
+    u8 *mapping = nullptr;
+    isize mappingSize = 0;
+
+#else
+
+    // Trace file
+    std::fstream stream;
+
+#endif
+
+public:
+
+    // Trace file loaded for inspection
+    TraceReader reader;
+
+
+    //
+    // Methods
+    //
+
+public:
+
+    using SubComponent::SubComponent;
+    ~Tracer();
+
+    Tracer& operator= (const Tracer& other) { return *this; }
+
+
+    //
+    // Methods from Serializable
+    //
+
+public:
+
+    template <class T> void serialize(T& worker) { } SERIALIZERS(serialize);
+
+
+    //
+    // Methods from CoreComponent
+    //
+
+public:
+
+    const Descriptions &getDescriptions() const override { return descriptions; }
+
+private:
+
+    void _dump(Category category, std::ostream &os) const override;
+
+
+    //
+    // Methods from Inspectable
+    //
+
+public:
+
+    void cacheInfo(TracerInfo &result) const override;
+
+
+    //
+    // Methods from Configurable
+    //
+
+public:
+
+    const TracerConfig &getConfig() const { return config; }
+    const Options &getOptions() const override { return options; }
+    i64 getOption(Opt opt) const override;
+    void checkOption(Opt opt, i64 value) override;
+    void setOption(Opt opt, i64 value) override;
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    // Indicates if a trace is being recorded
+    bool isTracing() const { return !path.empty(); }
+
+    // Indicates if the instructions of a certain CPU are recorded
+    bool traces(const class CPU &cpu) const;
+
+    // Starts recording into the specified file
+    void start(const fs::path &path);
+
+    // Stops recording and closes the trace file
+    void stop();
+
+    // Records the most recently logged instruction of a CPU
+    void record(const class CPU &cpu);
+
+    // Writes all collected records into the trace file
+    void flush();
+
+private:
+
+    // Enables or disables instruction logging in all traced CPUs
+    void updateLogging();
+
+    // Writes records or the header into the trace file
+    void write(isize pos, const TraceRecord *records, isize count);
+    void writeHeader();
+
+
+    //
+    // Inspecting
+    //
+
+public:
+
+    // Loads a trace file for inspection (the current trace if path is empty)
+    void open(const fs::path &path = "");
+
+    // Converts a record into a format understood by the disassembler
+    static peddle::RecordedInstruction toInstruction(const TraceRecord &record);
+
+    // Disassembles a range of records from the loaded trace file
+    void list(std::ostream &os, isize first, isize count) const;
+
+    // Lists all records of the loaded trace file at a certain address
+    void find(std::ostream &os, u16 pc, isize max) const;
+};
+
+}
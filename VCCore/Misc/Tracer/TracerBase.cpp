@@ -0,0 +1,115 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#include "vcconfig.h"
+#include "Tracer.h"
+#include "C64.h"
+
+namespace vc64 {
+
+void
+Tracer::_dump(Category category, std::ostream &os) const
+{
+    using namespace utl;
+
+    if (category == Category::Config) {
+
+        dumpConfig(os);
+    }
+
+    if (category == Category::State) {
+
+        auto info = getInfo();
+
+        os << tab("Tracing");
+        os << bol(info.tracing) << std::endl;
+        os << tab("Trace file");
+        os << (info.tracing ? path.string() : "-") << std::endl;
+        os << tab("Recorded instructions");
+        os << dec(info.records) << std::endl;
+        os << tab("Capacity");
+        os << dec(info.capacity) << " instructions" << std::endl;
+        os << tab("Loaded trace");
+        os << dec(reader.count()) << " instructions" << std::endl;
+    }
+}
+
+void
+Tracer::cacheInfo(TracerInfo &result) const
+{
+    {   SYNCHRONIZED
+
+        result.tracing = isTracing();
+        result.records = header.count + (isTracing() ? buffered : 0);
+        result.capacity = header.capacity;
+    }
+}
+
+i64
+Tracer::getOption(Opt option) const
+{
+    switch (option) {
+
+        case Opt::TRC_DRIVES:        return (i64)config.drives;
+        case Opt::TRC_SIZE:          return (i64)config.size;
+
+        default:
+            fatalError;
+    }
+}
+
+void
+Tracer::checkOption(Opt opt, i64 value)
+{
+    switch (opt) {
+
+        case Opt::TRC_DRIVES:
+
+            return;
+
+        case Opt::TRC_SIZE:
+
+            if (value < 1 || value > 4096) {
+                throw CoreError(CoreError::OPT_INV_ARG, "1...4096");
+            }
+            return;
+
+        default:
+            throw CoreError(CoreError::OPT_UNSUPPORTED);
+    }
+}
+
+void
+Tracer::setOption(Opt opt, i64 value)
+{
+    checkOption(opt, value);
+
+    switch (opt) {
+
+        case Opt::TRC_DRIVES:
+
+            config.drives = bool(value);
+            if (isTracing()) updateLogging();
+            return;
+
+        case Opt::TRC_SIZE:
+
+            // Takes effect when the next trace is started
+            config.size = isize(value);
+            return;
+
+        default:
+            fatalError;
+    }
+}
+
+}
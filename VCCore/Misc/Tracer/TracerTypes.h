@@ -0,0 +1,105 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+/// @file
+
+#pragma once
+
+#include "BasicTypes.h"
+
+namespace vc64 {
+
+//
+// Constants
+//
+
+//! Signature of a trace file
+static constexpr char TRACE_MAGIC[8] = { 'V', 'C', '6', '4', 'T', 'R', 'C', '1' };
+
+
+//
+// Structures
+//
+
+typedef struct
+{
+    //! Indicates if the drive CPUs are traced, too
+    bool drives;
+
+    //! Size of the trace file in MB
+    isize size;
+}
+TracerConfig;
+
+typedef struct
+{
+    //! Indicates if a trace is being recorded
+    bool tracing;
+
+    //! Number of recorded instructions
+    i64 records;
+
+    //! Maximum number of instructions kept in the trace file
+    i64 capacity;
+}
+TracerInfo;
+
+//! File header of a trace file
+typedef struct
+{
+    //! File signature (TRACE_MAGIC)
+    char magic[8];
+
+    //! Size of a single record in bytes
+    u32 recordSize;
+
+    //! Reserved for future use
+    u32 reserved;
+
+    //! Number of records the file can hold
+    i64 capacity;
+
+    //! Number of recorded instructions (may exceed the capacity)
+    i64 count;
+}
+TraceHeader;
+
+//! A single recorded instruction
+typedef struct
+{
+    //! CPU cycle of the instruction fetch
+    u64 cycle;
+
+    //! Instruction address
+    u16 pc;
+
+    //! Recording CPU (0 = C64, 1 = Drive 8, 2 = Drive 9)
+    u8 cpu;
+
+    //! Instruction bytes
+    u8 bytes[3];
+
+    //! Registers
+    u8 a;
+    u8 x;
+    u8 y;
+    u8 sp;
+    u8 flags;
+
+    //! Padding
+    u8 reserved[3];
+}
+TraceRecord;
+
+static_assert(sizeof(TraceHeader) == 32);
+static_assert(sizeof(TraceRecord) == 24);
+
+}
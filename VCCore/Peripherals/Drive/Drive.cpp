@@ -37,6 +37,20 @@ Drive::Drive(C64 &ref, isize id) : SubComponent(ref, id)
     cpu.setID(id == DRIVE8 ? 1 : 2);
 }
 
+void
+Drive::syncWith(Drive &other)
+{
+    mem.syncWith(other.mem);
+    cloneState(other);
+
+    // Fall back to a full copy while a disk change is in progress
+    if (disk && other.disk && !diskToInsert && !other.diskToInsert) {
+        disk->syncWith(*other.disk);
+    } else {
+        cloneDisks(other);
+    }
+}
+
 void
 Drive::_initialize()
 {    
@@ -61,26 +75,88 @@ Drive::execute(u64 duration)
 {
     elapsedTime += duration;
     
-    while (nextClock < (i64)elapsedTime || nextCarry < (i64)elapsedTime) {
+    while (nextClock < (i64)elapsedTime) {
 
-        if (nextClock <= nextCarry) {
-            
-            // Execute CPU and VIAs
-            i64 cycle = ++cpu.clock;
-            cpu.execute<CPURevision::MOS_6502>();
-            if (cycle >= via1.wakeUpCycle) via1.execute(); else via1.idleCounter++;
-            if (cycle >= via2.wakeUpCycle) via2.execute(); else via2.idleCounter++;
-            updateByteReady();
-            nextClock += 10000;
+        // Execute read/write logic unless it can be deferred further
+        if (nextClock > carryHorizon) {
 
-        } else {
-            
-            // Execute read/write logic
-            if (spinning) executeUF4();
-            nextCarry += delayBetweenTwoCarryPulses[zone];
+            catchUp();
+            carryHorizon = computeCarryHorizon();
+        }
+
+        // Execute CPU and VIAs
+        i64 cycle = ++cpu.clock;
+        cpu.execute<CPURevision::MOS_6502>();
+        if (cycle >= via1.wakeUpCycle) via1.execute(); else via1.idleCounter++;
+        if (cycle >= via2.wakeUpCycle) { catchUp(); via2.execute(); } else via2.idleCounter++;
+        updateByteReady();
+        nextClock += 10000;
+    }
+    assert(nextClock >= (i64)elapsedTime);
+}
+
+void
+Drive::catchUp()
+{
+    // Process all carry pulses up to the current drive cycle
+    auto until = std::min(nextClock, (i64)elapsedTime);
+    auto delay = (i64)delayBetweenTwoCarryPulses[zone];
+
+    if (nextCarry < until && spinning) {
+
+        if (fastRead() && readMode() && hasDisk() &&
+            offset < disk->lengthOfHalftrack(halftrack)) {
+
+            // Advance to the next bit boundary
+            while (nextCarry < until && (carryCounter & 3)) {
+
+                executeUF4();
+                nextCarry += delay;
+            }
+
+            // Read entire bits while UF4 is in sync with the bit clock
+            while (nextCarry + 3 * delay < until && (counterUF4 & 3) == 0) {
+
+                executeUF4Bit();
+                nextCarry += 4 * delay;
+            }
+        }
+        while (nextCarry < until) {
+
+            executeUF4();
+            nextCarry += delay;
         }
     }
-    assert(nextClock >= (i64)elapsedTime && nextCarry >= (i64)elapsedTime);
+    while (nextCarry < until) nextCarry += delay;
+
+    // Changes to VIA2 may invalidate the current horizon
+    carryHorizon = 0;
+}
+
+i64
+Drive::computeCarryHorizon() const
+{
+    // In write mode or while the byte ready line is low, nothing is deferred
+    if (!fastRead() || writeMode() || !byteReady) return 0;
+
+    // Never defer more than a single byte
+    i64 pulses = 32;
+
+    if (spinning && via2.getCA2()) {
+
+        /* Byte ready goes low in the first QBQA = 00 phase after the byte
+         * ready counter has reached 7. A sync mark can only reset the counter
+         * and delay this event. If UF4 runs in sync with the bit clock, QBQA
+         * equals 10 in every fourth pulse and we can tell how many pulses are
+         * safe to defer.
+         */
+        if (byteReadyCounter == 7 || ((counterUF4 - carryCounter) & 3)) return 0;
+
+        i64 first = ((1 - carryCounter) & 3) + 1;
+        pulses = std::min(pulses, first + 4 * (6 - byteReadyCounter) + 1);
+    }
+
+    return nextCarry + pulses * (i64)delayBetweenTwoCarryPulses[zone];
 }
 
 void
@@ -177,6 +253,42 @@ Drive::executeUF4()
     }
 }
 
+void
+Drive::executeUF4Bit()
+{
+    assert(readMode() && hasDisk());
+    assert((carryCounter & 3) == 0 && (counterUF4 & 3) == 0);
+    assert(offset < disk->lengthOfHalftrack(halftrack));
+
+    // QBQA = 01: Update the byte ready line
+    counterUF4++;
+    sync = (readShiftreg & 0x3FF) != 0x3FF;
+    if (!sync) byteReadyCounter = 0;
+    updateByteReady();
+
+    // QBQA = 10: Execute UE3 and the shift registers
+    counterUF4++;
+    raiseByteReady();
+    byteReadyCounter = sync ? (byteReadyCounter + 1) & 7 : 0;
+    writeShiftreg <<= 1;
+    readShiftreg <<= 1;
+    readShiftreg |= ((counterUF4 & 0x0C) == 0);
+
+    // QBQA = 11: Load the write shift register
+    counterUF4++;
+    sync = (readShiftreg & 0x3FF) != 0x3FF;
+    if (!sync) byteReadyCounter = 0;
+    if (byteReadyCounter == 7) writeShiftreg = via2.getPA();
+
+    // QBQA = 00: Read the next bit and update the byte ready line
+    counterUF4++;
+    if (disk->_readBitFromHalftrack(halftrack, offset)) counterUF4 = 0;
+    if (++offset >= disk->length.halftrack[halftrack]) offset = 0;
+    updateByteReady();
+
+    carryCounter += 4;
+}
+
 void
 Drive::updateByteReady()
 {
@@ -276,6 +388,9 @@ Drive::wakeUp(isize awakeness)
         logdebug(DRV_DEBUG, "Exiting power-safe mode\n");
         msgQueue.put(Msg::DRIVE_POWER_SAVE, DriveMsg { .nr = i16(objid), .value = 0 } );
         needsEmulation = true;
+
+        // Make the run loop leave the fast path (not needed on the drive thread)
+        if (!DriveThread::isWorker()) c64.setFlag(RL::DRIVE_WAKEUP);
     }
 
     watchdog = awakeness;
@@ -534,6 +649,7 @@ Drive::vsyncHandler()
         if (--watchdog == 0) {
 
             logdebug(DRV_DEBUG, "Entering power-save mode\n");
+            catchUp();
             needsEmulation = false;
             msgQueue.put(Msg::DRIVE_POWER_SAVE, DriveMsg { .nr = i16(objid), .value = 1 } );
         }
@@ -568,6 +684,9 @@ Drive::scheduleFirstDiskChangeEvent(EventID id)
 void
 Drive::processDiskChangeEvent(EventID id)
 {
+    // Let the read logic catch up before the disk is manipulated
+    catchUp();
+
     auto reschedule = [&](isize delay) {
 
         Cycle cycles = vic.getCyclesPerFrame() * delay;
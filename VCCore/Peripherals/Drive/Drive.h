@@ -169,6 +169,14 @@ private:
      * 1. The carry signal drives uf4, a counter of the same type.
      */
     i64 nextCarry = 0;
+
+    /* Indicates how long carry pulses may be processed lazily. As long as the
+     * byte ready line cannot change, the effects of the read logic are only
+     * visible through the VIA2 registers. Hence, all carry pulses occurring
+     * before this point in time are collected and processed in a single go,
+     * either when VIA2 is accessed or when the horizon has been reached.
+     */
+    i64 carryHorizon = 0;
     
 public:
     
@@ -265,6 +273,20 @@ public:
     Drive& operator= (const Drive& other) {
 
         CLONE(mem)
+        cloneState(other);
+        cloneDisks(other);
+
+        return *this;
+    }
+
+    // Copies only those parts of another drive that have been modified
+    void syncWith(Drive &other);
+
+private:
+
+    // Clones everything except the memory and the disks
+    void cloneState(const Drive& other) {
+
         CLONE(cpu)
         CLONE(via1)
         CLONE(via2)
@@ -275,6 +297,7 @@ public:
         CLONE(elapsedTime)
         CLONE(nextClock)
         CLONE(nextCarry)
+        CLONE(carryHorizon)
         CLONE(carryCounter)
         CLONE(counterUF4)
         CLONE(bitReadyTimer)
@@ -292,6 +315,10 @@ public:
         CLONE(insertionStatus)
 
         CLONE(config)
+    }
+
+    // Clones the inserted disk and the disk waiting to be inserted
+    void cloneDisks(const Drive& other) {
 
         if (other.disk && !disk) disk = std::make_unique<FloppyDisk>();
         if (!other.disk) disk = nullptr;
@@ -300,8 +327,6 @@ public:
         if (other.diskToInsert && !diskToInsert) diskToInsert = std::make_unique<FloppyDisk>();
         if (!other.diskToInsert) diskToInsert = nullptr;
         if (diskToInsert) *diskToInsert = *other.diskToInsert;
-
-        return *this;
     }
 
 
@@ -381,6 +406,7 @@ private:
     void _run() override;
     void _dump(Category category, std::ostream &os) const override;
     void _didReset(bool hard) override;
+    void _didLoad() override;
 
 
     //
@@ -538,9 +564,21 @@ private:
     
     // Emulates a trigger event on the carry output pin of UE7.
     void executeUF4();
-    
+
+    // Emulates four trigger events in a row (fast path for reading a bit)
+    void executeUF4Bit();
+
+    // Determines how long carry pulses can be processed lazily
+    i64 computeCarryHorizon() const;
+
+    // Checks if carry pulses may be deferred and processed bit-wise
+    bool fastRead() const { return config.powerSave && !debug::DSK_SAFE_MODE; }
+
 public:
 
+    // Processes all carry pulses that have been deferred so far
+    void catchUp();
+
     // Returns the current access mode of this drive (read or write)
     bool readMode() const { return via2.getCB2(); }
     bool writeMode() const { return !readMode(); }
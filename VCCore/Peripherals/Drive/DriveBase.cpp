@@ -145,10 +145,17 @@ Drive::_didReset(bool hard)
 {
     cpu.reg.pc = 0xEAA0;
     halftrack = 41;
+    carryHorizon = 0;
 
     needsEmulation = config.connected && config.switchedOn;
 }
 
+void
+Drive::_didLoad()
+{
+    carryHorizon = 0;
+}
+
 void
 Drive::resetConfigItems(const class Defaults &defaults, isize objid)
 {
@@ -22,6 +22,21 @@ DriveMemory::DriveMemory(C64 &ref, Drive &dref) : SubComponent(ref), drive(dref)
     updateBankMap();
 }
 
+void
+DriveMemory::syncWith(DriveMemory &other)
+{
+    // Copy all pages that have been modified in either instance
+    auto pages = dirtyRam;
+    pages |= other.dirtyRam;
+    pages.forEach([&](isize nr) { memcpy(ram + 256 * nr, other.ram + 256 * nr, 256); });
+
+    dirtyRam.clear();
+    other.dirtyRam.clear();
+
+    // The ROM can only be changed by API calls which enforce a full clone
+    CLONE_ARRAY(usage)
+}
+
 u16
 DriveMemory::romSize() const
 {
@@ -165,6 +180,7 @@ DriveMemory::peek(u16 addr)
             
         case DrvMemType::VIA2:
             
+            drive.catchUp();
             result = drive.via2.peek(addr & 0xF);
             break;
 
@@ -237,11 +253,13 @@ DriveMemory::poke(u16 addr, u8 value)
         case DrvMemType::RAM:
             
             ram[addr & 0x07FF] = value;
+            dirtyRam.mark((addr & 0x07FF) >> 8);
             break;
             
         case DrvMemType::EXP:
             
             ram[addr] = value;
+            dirtyRam.mark(addr >> 8);
             break;
             
         case DrvMemType::VIA1:
@@ -251,6 +269,7 @@ DriveMemory::poke(u16 addr, u8 value)
             
         case DrvMemType::VIA2:
             
+            drive.catchUp();
             drive.via2.poke(addr & 0xF, value);
             break;
             
@@ -14,6 +14,7 @@
 
 #include "SubComponent.h"
 #include "DriveTypes.h"
+#include "DirtyPages.h"
 
 namespace vc64 {
 
@@ -51,6 +52,9 @@ public:
     u8 ram[0xA000];
     u8 rom[0x8000] = {};
 
+    // Modified RAM pages (used to synchronize the run-ahead instance)
+    DirtyPages<0xA0> dirtyRam;
+
     // Memory usage table (one entry for each KB)
     DrvMemType usage[64];
     
@@ -72,6 +76,9 @@ public:
         return *this;
     }
 
+    // Copies all RAM pages that differ from another instance
+    void syncWith(DriveMemory &other);
+
     
     //
     // Methods from Serializable
@@ -170,8 +177,8 @@ public:
 
     // Writes a value into memory
     void poke(u16 addr, u8 value);
-    void pokeZP(u8 addr, u8 value) { ram[addr] = value; }
-    void pokeStack(u8 sp, u8 value) { ram[0x100 + sp] = value; }
+    void pokeZP(u8 addr, u8 value) { ram[addr] = value; dirtyRam.mark(0); }
+    void pokeStack(u8 sp, u8 value) { ram[0x100 + sp] = value; dirtyRam.mark(1); }
 
     // Updates the bank map
     void updateBankMap();
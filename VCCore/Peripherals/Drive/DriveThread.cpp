@@ -0,0 +1,175 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#include "vcconfig.h"
+#include "DriveThread.h"
+#include "C64.h"
+
+namespace vc64 {
+
+// Number of unsuccessful polls before a waiting thread yields
+static constexpr isize spinLimit = 64;
+
+DriveThread::~DriveThread()
+{
+    {   std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    cond.notify_all();
+
+    if (thread.joinable()) thread.join();
+}
+
+bool
+DriveThread::canTakeOver() const
+{
+    auto &drive8 = c64.drive8;
+    auto &drive9 = c64.drive9;
+
+    // Only the primary instance emulates the drives in parallel
+    if (!c64.getConfig().driveThread || c64.isRunAheadInstance()) return false;
+
+    // Parallel cables require a lockstep execution
+    if (drive8.getParCableType() != ParCableType::NONE) return false;
+    if (drive9.getParCableType() != ParCableType::NONE) return false;
+
+    // Breakpoints, watchpoints, and the tracer require a lockstep execution
+    if (drive8.cpu.isObserved() || drive9.cpu.isObserved()) return false;
+
+    return true;
+}
+
+void
+DriveThread::begin(bool enable8, bool enable9, i64 duration)
+{
+    assert(!active);
+
+    {   std::unique_lock<std::mutex> lock(mutex);
+
+        // Launch the worker thread if it isn't running yet
+        if (!thread.joinable()) thread = std::thread(&DriveThread::main, this);
+
+        // Wait until the worker thread is ready to take over
+        cond.wait(lock, [this]() { return parked; });
+
+        this->enable8 = enable8;
+        this->enable9 = enable9;
+        this->duration = duration;
+
+        horizon = c64.cpu.clock;
+        done = c64.cpu.clock;
+        running = true;
+    }
+    cond.notify_all();
+
+    active = true;
+}
+
+void
+DriveThread::end()
+{
+    if (!active) return;
+
+    // Let the drives complete the current cycle
+    waitFor(c64.cpu.clock);
+
+    {   std::unique_lock<std::mutex> lock(mutex);
+
+        // Send the worker thread back to the parking position
+        running = false;
+        cond.wait(lock, [this]() { return parked; });
+    }
+
+    active = false;
+
+    // Schedule the bus update requested by the drives in the last cycle
+    c64.iec.finishPendingUpdate(true);
+}
+
+void
+DriveThread::sync()
+{
+    if (!active) return;
+
+    // Let the drives complete the previous cycle
+    waitFor(c64.cpu.clock - 1);
+
+    // Process the bus update requested by the drives in that cycle
+    c64.iec.finishPendingUpdate(false);
+}
+
+void
+DriveThread::waitFor(Cycle cycle)
+{
+    advance(cycle);
+
+    for (isize spins = 0; done.load(std::memory_order_acquire) < cycle; spins++) {
+        if (spins >= spinLimit) std::this_thread::yield();
+    }
+}
+
+void
+DriveThread::main()
+{
+    loginfo(DRV_DEBUG, "Drive thread launched\n");
+
+    worker = true;
+
+    while (true) {
+
+        // Wait for the next frame
+        {   std::unique_lock<std::mutex> lock(mutex);
+
+            parked = true;
+            cond.notify_all();
+            cond.wait(lock, [this]() { return quit || running; });
+            if (quit) break;
+            parked = false;
+        }
+
+        // Follow the C64 until the drives are taken back
+        auto cycle = done.load(std::memory_order_relaxed);
+
+        for (isize spins = 0; running.load(std::memory_order_acquire); spins++) {
+
+            auto target = horizon.load(std::memory_order_acquire);
+
+            if (cycle < target) {
+
+                // Emulate all cycles the C64 has already completed
+                do { execute(); done.store(++cycle, std::memory_order_release); } while (cycle < target);
+                spins = 0;
+
+            } else if (spins >= spinLimit) {
+
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    loginfo(DRV_DEBUG, "Drive thread terminated\n");
+}
+
+void
+DriveThread::execute()
+{
+    auto &drive8 = c64.drive8;
+    auto &drive9 = c64.drive9;
+
+    // Process the bus update requested by the drives in the previous cycle
+    if (c64.iec.pendingUpdate) c64.iec.update();
+
+    if (enable8 && drive8.needsEmulation) drive8.execute(duration);
+    if (enable9 && drive9.needsEmulation) drive9.execute(duration);
+}
+
+}
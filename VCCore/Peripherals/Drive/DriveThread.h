@@ -0,0 +1,143 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreObject.h"
+#include "C64Types.h"
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+
+namespace vc64 {
+
+class C64;
+
+/* The drive thread emulates the floppy drives in parallel to the C64. At the
+ * beginning of a frame, the C64 hands both drives over to the worker thread
+ * and publishes its progress at the end of each scanline. The worker follows
+ * the C64 cycle by cycle, but never overtakes it.
+ *
+ * The C64 and the drives only interact via the IEC bus. Before the C64 touches
+ * the bus (by accessing the data port of CIA2 or by processing a bus update
+ * event), it waits for the drives to catch up with the previous cycle. Bus
+ * updates triggered by the drives are not scheduled as C64 events. They are
+ * recorded in the serial port and processed in the next cycle by whichever
+ * thread gets there first. This keeps the emulation cycle-identical to the
+ * interleaved execution. At the end of the frame, the C64 takes the drives
+ * back, which means that all other components see the usual state between
+ * two frames.
+ *
+ * Drives connected via a parallel cable trigger interrupts inside the C64
+ * without warning. They are always emulated on the C64 thread, as well as
+ * drives whose CPU is debugged or traced.
+ */
+class DriveThread final : public CoreObject {
+
+    // Reference to the emulated C64
+    C64 &c64;
+
+    // The worker thread
+    std::thread thread;
+
+    // Synchronization primitives for handing over the drives
+    std::mutex mutex;
+    std::condition_variable cond;
+
+    // Indicates if the drives are owned by the worker thread
+    bool active = false;
+
+    // Indicates if the worker thread waits for the next frame
+    bool parked = false;
+
+    // Indicates if the worker thread should terminate
+    bool quit = false;
+
+    // Indicates if the worker thread should follow the C64
+    std::atomic<bool> running = false;
+
+    // The last cycle that has been completed by the C64
+    std::atomic<Cycle> horizon = 0;
+
+    // The last cycle that has been completed by the drives
+    std::atomic<Cycle> done = 0;
+
+    // Emulated drives (fixed for the duration of a frame)
+    bool enable8 = false;
+    bool enable9 = false;
+
+    // Duration of a CPU cycle in 1/10 nano seconds (fixed for a frame)
+    i64 duration = 0;
+
+    // Indicates if the calling thread is a drive thread
+    inline static thread_local bool worker = false;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    DriveThread(C64 &ref) : c64(ref) { }
+    ~DriveThread();
+
+    const char *objectName() const override { return "DriveThread"; }
+
+
+    //
+    // Handing over the drives
+    //
+
+public:
+
+    // Indicates if the drives are currently emulated by the worker thread
+    bool isActive() const { return active; }
+
+    // Indicates if the calling thread is a drive thread
+    static bool isWorker() { return worker; }
+
+    // Checks if the drives can be emulated on the worker thread
+    bool canTakeOver() const;
+
+    // Hands the specified drives over to the worker thread
+    void begin(bool enable8, bool enable9, i64 duration);
+
+    // Takes the drives back (called at the end of a frame)
+    void end();
+
+
+    //
+    // Synchronizing
+    //
+
+public:
+
+    // Informs the worker thread about the progress of the C64
+    void advance(Cycle cycle) { horizon.store(cycle, std::memory_order_release); }
+
+    // Lets the drives catch up with the previous cycle of the C64
+    void sync();
+
+private:
+
+    // Waits until the drives have completed the specified cycle
+    void waitFor(Cycle cycle);
+
+    // The main thread function
+    void main();
+
+    // Emulates the drives for a single cycle
+    void execute();
+};
+
+}
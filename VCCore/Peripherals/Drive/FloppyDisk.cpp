@@ -469,11 +469,30 @@ FloppyDisk::_bitDelay(Halftrack ht, HeadPos pos) const {
     return 4 * 8125;     // Density bits = 11: 4 * 13/16 * 10^4 1/10 nsec
 }
 
+void
+FloppyDisk::syncWith(FloppyDisk &other)
+{
+    // Copy all halftracks that have been modified on either disk
+    auto halftracks = dirtyHalftracks;
+    halftracks |= other.dirtyHalftracks;
+    halftracks.forEach([&](isize ht) {
+        memcpy(data.halftrack[ht], other.data.halftrack[ht], sizeof(data.halftrack[ht]));
+    });
+
+    dirtyHalftracks.clear();
+    other.dirtyHalftracks.clear();
+
+    CLONE(writeProtected)
+    CLONE(modified)
+    CLONE(length)
+}
+
 void
 FloppyDisk::clearHalftrack(Halftrack ht)
 {
     memset(&data.halftrack[ht], 0x55, sizeof(data.halftrack[ht]));
     length.halftrack[ht] = sizeof(data.halftrack[ht]) * 8;
+    dirtyHalftracks.mark(ht);
 }
 
 void
@@ -18,6 +18,7 @@
 #include "FileSystems/CBM/FSTypes.h"
 #include "FileSystems/CBM/FSObjects.h"
 #include "Images/FloppyDiskImage.h"
+#include "DirtyPages.h"
 
 namespace vc64 {
 
@@ -89,6 +90,9 @@ public:
     
     // Length information for each halftrack on this disk
     DiskLength length = { };
+
+    // Modified halftracks (used to synchronize the run-ahead instance)
+    DirtyPages<85> dirtyHalftracks;
     
     
     //
@@ -144,6 +148,9 @@ public:
         
         return *this;
     }
+
+    // Copies all halftracks that differ from another disk
+    void syncWith(FloppyDisk &other);
     
     
     //
@@ -285,6 +292,7 @@ public:
         } else {
             data.halftrack[ht][pos >> 3] &= (0xFF7F >> (pos & 7));
         }
+        dirtyHalftracks.mark(ht);
     }
     void _writeBitToTrack(Track t, HeadPos pos, bool bit) {
         _writeBitToHalftrack(2 * t - 1, pos, bit);
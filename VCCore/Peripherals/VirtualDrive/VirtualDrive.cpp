@@ -0,0 +1,626 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#include "vcconfig.h"
+#include "VirtualDrive.h"
+#include "C64.h"
+#include "Emulator.h"
+#include "Codecs.h"
+#include "utl/io/IOError.h"
+
+namespace vc64 {
+
+using retro::vault::Volume;
+
+// Zero page locations used by the KERNAL
+static constexpr u16 STATUS = 0x90;     // I/O status word
+static constexpr u16 VERCK  = 0x93;     // Load or verify flag
+static constexpr u16 EAL    = 0xAE;     // End address of a loaded file
+static constexpr u16 FNLEN  = 0xB7;     // Length of the file name
+static constexpr u16 SA     = 0xB9;     // Secondary address
+static constexpr u16 FA     = 0xBA;     // Device number
+static constexpr u16 FNADR  = 0xBB;     // Address of the file name
+static constexpr u16 MEMUSS = 0xC3;     // Start address of a loaded file
+static constexpr u16 ILOAD  = 0x330;    // LOAD vector
+
+// Returns the length of a file name that is padded with shifted spaces
+static isize
+nameLength(const u8 *name)
+{
+    isize len = 0;
+    while (len < 16 && name[len] != 0xA0) len++;
+    return len;
+}
+
+// Checks if a file name matches a pattern with wildcards
+static bool
+matches(const u8 *name, isize len, const string &pattern)
+{
+    for (isize i = 0; i < isize(pattern.size()); i++) {
+
+        if (pattern[i] == '*') return true;
+        if (i >= len) return false;
+        if (pattern[i] != '?' && u8(pattern[i]) != name[i]) return false;
+    }
+    return len == isize(pattern.size());
+}
+
+// Creates a BASIC program listing the directory
+static void
+makeDirectory(const FileSystem &fs, const string &pattern, std::vector<u8> &data)
+{
+    static constexpr const char *types[8] = {
+        "DEL", "SEQ", "PRG", "USR", "REL", "???", "???", "???"
+    };
+
+    auto line = [&](isize nr, const string &text) {
+
+        // The link pointer is a dummy value which is fixed by BASIC
+        data.insert(data.end(), { 0x01, 0x01, LO_BYTE(nr), HI_BYTE(nr) });
+        data.insert(data.end(), text.begin(), text.end());
+        data.push_back(0);
+    };
+
+    auto petscii = [](u8 c) { return char(c == 0xA0 ? ' ' : c); };
+
+    // Load address
+    data = { 0x01, 0x04 };
+
+    // Disk name and ID
+    string header = "\x12\"";
+    if (auto *bam = fs.tryFetchBAM()) {
+
+        auto *p = bam->data();
+        for (isize i = 0x90; i < 0xA0; i++) header += petscii(p[i]);
+        header += "\" ";
+        for (isize i = 0xA2; i < 0xA7; i++) header += petscii(p[i]);
+    }
+    line(0, header);
+
+    // Files
+    for (auto &entry : fs.readDir()) {
+
+        if (entry.deleted()) continue;
+
+        auto len = nameLength(entry.fileName);
+        if (!matches(entry.fileName, len, pattern)) continue;
+
+        auto blocks = entry.getFileSize();
+        string text = blocks < 10 ? "   " : blocks < 100 ? "  " : " ";
+        text += "\"" + string((const char *)entry.fileName, len) + "\"";
+        text += string(16 - len, ' ');
+        text += (entry.fileType & 0x80) ? " " : "*";
+        text += types[entry.fileType & 0x07];
+        text += (entry.fileType & 0x40) ? "<" : " ";
+        line(blocks, text);
+    }
+
+    // Free blocks
+    line(fs.stat().freeBlocks, "BLOCKS FREE.             ");
+
+    // End of program
+    data.insert(data.end(), { 0x00, 0x00 });
+}
+
+void
+VirtualDrive::attach(isize nr, const fs::path &path)
+{
+    if (nr < VDR_FIRST || nr >= VDR_FIRST + VDR_COUNT) {
+        throw CoreError(CoreError::OPT_INV_ARG, "8...11");
+    }
+    if (!fs::exists(path)) {
+        throw IOError(IOError::FILE_NOT_FOUND, path);
+    }
+
+    // Create a disk and convert it into a D64 image
+    auto disk = FloppyDisk(path, true);
+    std::shared_ptr<D64File> d64 = Codec::makeD64(disk);
+
+    media[nr - VDR_FIRST] = d64;
+    device[nr - VDR_FIRST] = Device { };
+}
+
+void
+VirtualDrive::detach(isize nr)
+{
+    if (nr < VDR_FIRST || nr >= VDR_FIRST + VDR_COUNT) {
+        throw CoreError(CoreError::OPT_INV_ARG, "8...11");
+    }
+
+    media[nr - VDR_FIRST] = nullptr;
+    device[nr - VDR_FIRST] = Device { };
+}
+
+bool
+VirtualDrive::isVirtual(isize nr) const
+{
+    if (!config.enable) return false;
+    if (nr < VDR_FIRST || nr >= VDR_FIRST + VDR_COUNT) return false;
+
+    auto i = nr - VDR_FIRST;
+    if (device[i].fallback) return false;
+    if (media[i]) return true;
+
+    return i < 2 && drive[i]->connectedAndOn();
+}
+
+bool
+VirtualDrive::canFallBack(isize nr) const
+{
+    auto i = nr - VDR_FIRST;
+    return config.fallback && i < 2 && !media[i] && drive[i]->connectedAndOn();
+}
+
+isize
+VirtualDrive::readFile(isize nr, const string &name, std::vector<u8> &data)
+{
+    auto i = nr - VDR_FIRST;
+    data.clear();
+
+    try {
+
+        // Get the medium (decode the disk of the emulated drive if needed)
+        std::shared_ptr<D64File> d64 = media[i];
+        if (!d64) {
+
+            // Make sure the drive thread doesn't modify the disk concurrently
+            c64.driveThread.sync();
+
+            if (!drive[i]->hasDisk()) return 74;
+            d64 = Codec::makeD64(*drive[i]->disk);
+        }
+
+        // Create a file system on top
+        auto vol = Volume(*d64);
+        auto fs  = FileSystem(vol);
+
+        if (name[0] == '$') {
+
+            // Strip off the drive number
+            auto pos = name.find(':');
+            makeDirectory(fs, pos == string::npos ? "*" : name.substr(pos + 1), data);
+            return 0;
+        }
+
+        for (auto &entry : fs.readDir()) {
+
+            if ((entry.fileType & 0x07) == 0) continue;
+            if (!matches(entry.fileName, nameLength(entry.fileName), name)) continue;
+
+            Buffer<u8> buf;
+            fs.extractData(entry, buf);
+            data.assign(buf.ptr, buf.ptr + buf.size);
+            return 0;
+        }
+        return 62;
+
+    } catch (...) {
+
+        return 74;
+    }
+}
+
+void
+VirtualDrive::updateTraps()
+{
+    static constexpr u16 vectors[TRAP_COUNT] = {
+
+        0xFFB4, // TALK
+        0xFFB1, // LISTEN
+        0xFF93, // SECOND
+        0xFF96, // TKSA
+        0xFFA5, // ACPTR
+        0xFFA8, // CIOUT
+        0xFFAB, // UNTLK
+        0xFFAE, // UNLSN
+        0xFFD5  // LOAD
+    };
+
+    // Only intercept routines which are reached through a JMP instruction
+    for (isize i = 0; i < TRAP_COUNT; i++) {
+
+        auto *p = mem.rom + vectors[i];
+        trapAddr[i] = p[0] == 0x4C ? LO_HI(p[1], p[2]) : 0;
+    }
+
+    // Let the CPU report each instruction boundary
+    config.enable ? cpu.enableTraps() : cpu.disableTraps();
+}
+
+void
+VirtualDrive::processTrap(u16 addr)
+{
+    if (!config.enable) return;
+
+    // Check if a replayed bus transaction is waiting for the next step
+    if (replayPos >= 0 && addr == trapAddr[UNLSN]) { replay(); return; }
+
+    // Only intercept the KERNAL Rom
+    if (mem.getPeekSource(addr) != MemType::KERNAL) return;
+
+    // Don't mistake returning from an interrupt for calling a routine
+    if (mem.spypeek(cpu.getPC0()) == 0x40) return;
+
+    auto a = cpu.reg.a;
+
+    if (addr == trapAddr[TALK]) { processTalk(a); return; }
+    if (addr == trapAddr[LISTEN]) { processListen(a); return; }
+    if (addr == trapAddr[ACPTR]) { processAcptr(); return; }
+    if (addr == trapAddr[LOAD]) { processLoad(); return; }
+
+    if (addr == trapAddr[SECOND] || addr == trapAddr[CIOUT]) {
+
+        if (listener) {
+
+            transaction.push_back({ addr == trapAddr[SECOND] ? SECOND : CIOUT, a });
+            returnFromTrap();
+        }
+        return;
+    }
+
+    if (addr == trapAddr[TKSA]) {
+
+        if (talker) {
+
+            talkChannel = a & 0x0F;
+            returnFromTrap();
+        }
+        return;
+    }
+
+    if (addr == trapAddr[UNTLK]) {
+
+        if (talker) {
+
+            talker = 0;
+            returnFromTrap();
+        }
+        return;
+    }
+
+    if (addr == trapAddr[UNLSN]) {
+
+        if (listener) processUnlisten();
+        return;
+    }
+}
+
+void
+VirtualDrive::returnFromTrap(bool carry)
+{
+    // Emulate RTS
+    auto sp = cpu.reg.sp;
+    auto lo = mem.ram[0x100 + u8(sp + 1)];
+    auto hi = mem.ram[0x100 + u8(sp + 2)];
+
+    cpu.reg.sp = u8(sp + 2);
+    cpu.reg.pc = u16(LO_HI(lo, hi) + 1);
+    cpu.setC(carry);
+}
+
+void
+VirtualDrive::processTalk(u8 nr)
+{
+    if (!isVirtual(nr)) return;
+
+    talker = nr;
+    talkChannel = 0;
+    returnFromTrap();
+}
+
+void
+VirtualDrive::processListen(u8 nr)
+{
+    if (!isVirtual(nr)) return;
+
+    listener = nr;
+    transaction.clear();
+    transaction.push_back({ LISTEN, nr });
+    returnFromTrap();
+}
+
+void
+VirtualDrive::processAcptr()
+{
+    if (!talker) return;
+
+    auto &dev = device[talker - VDR_FIRST];
+    u8 byte = 0x0D;
+    bool last = true;
+
+    if (talkChannel == 15) {
+
+        // Read the error channel
+        auto msg = dev.status + "\r";
+        byte = u8(msg[dev.statusPos++]);
+        last = dev.statusPos >= isize(msg.size());
+        if (last) setStatus(talker, 0, "OK");
+
+    } else if (auto &ch = dev.channel[talkChannel]; ch.open && ch.pos < isize(ch.data.size())) {
+
+        // Read the next byte from the file
+        byte = ch.data[ch.pos++];
+        last = ch.pos >= isize(ch.data.size());
+        dev.bytes++;
+
+    } else {
+
+        // There is nothing to read (time out)
+        mem.pokeZP(STATUS, mem.ram[STATUS] | 0x02);
+    }
+
+    if (last) mem.pokeZP(STATUS, mem.ram[STATUS] | 0x40);
+    cpu.reg.a = byte;
+    returnFromTrap();
+}
+
+void
+VirtualDrive::processUnlisten()
+{
+    auto nr = listener;
+    listener = 0;
+
+    // Decode the transaction (LISTEN, SECOND, CIOUT, ...)
+    isize sa = -1;
+    string data;
+    for (auto &step : transaction) {
+
+        if (step.first == SECOND) sa = step.second;
+        if (step.first == CIOUT) data += char(step.second);
+    }
+
+    // A LISTEN without a secondary address is ignored by the drive
+    if (sa < 0) { returnFromTrap(); return; }
+
+    switch (sa & 0xF0) {
+
+        case 0xF0:  processOpen(nr, sa & 0x0F, data); break;
+        case 0xE0:  processClose(nr, sa & 0x0F); break;
+
+        case 0x60:
+
+            if ((sa & 0x0F) == 15) {
+
+                if (!data.empty()) processCommand(nr, data);
+
+            } else if (!data.empty() && !fallBack(nr)) {
+
+                // Writing files is not supported
+                setStatus(nr, 26, "WRITE PROTECT ON");
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    // Return unless the transaction is being replayed
+    if (replayPos < 0) returnFromTrap();
+}
+
+void
+VirtualDrive::processOpen(isize nr, isize sa, const string &name)
+{
+    auto &dev = device[nr - VDR_FIRST];
+
+    // Opening the command channel executes the file name as a command
+    if (sa == 15) {
+
+        if (!name.empty()) processCommand(nr, name);
+        return;
+    }
+
+    auto &ch = dev.channel[sa];
+    ch = Channel { };
+
+    // Requests that cannot be handled are passed to the emulated drive
+    auto unsupported = [&](isize code, const string &msg) {
+        if (!fallBack(nr)) setStatus(nr, code, msg);
+    };
+
+    // Strip off the drive number and split the file name from the type and mode
+    auto file = name;
+    if (auto pos = file.find(':'); pos != string::npos && file[0] != '$') file = file.substr(pos + 1);
+    auto params = string();
+    if (auto pos = file.find(','); pos != string::npos) { params = file.substr(pos); file = file.substr(0, pos); }
+
+    if (file.empty()) { unsupported(34, "SYNTAX ERROR"); return; }
+
+    // Direct access buffers and write accesses are not supported
+    if (file[0] == '#' || name[0] == '@' || sa == 1 ||
+        params.find(",W") != string::npos || params.find(",A") != string::npos) {
+
+        unsupported(26, "WRITE PROTECT ON");
+        return;
+    }
+
+    auto code = readFile(nr, file, ch.data);
+
+    switch (code) {
+
+        case 0:
+
+            ch.open = true;
+            dev.files++;
+            setStatus(nr, 0, "OK");
+            break;
+
+        case 62:
+
+            setStatus(nr, 62, "FILE NOT FOUND");
+            break;
+
+        default:
+
+            setStatus(nr, code, "DRIVE NOT READY");
+            break;
+    }
+}
+
+void
+VirtualDrive::processClose(isize nr, isize sa)
+{
+    if (sa < 15) device[nr - VDR_FIRST].channel[sa] = Channel { };
+}
+
+void
+VirtualDrive::processCommand(isize nr, const string &cmd)
+{
+    // Strip off trailing carriage returns
+    auto command = cmd.substr(0, cmd.find_last_not_of('\r') + 1);
+
+    if (command.empty() || command[0] == 'I') {
+
+        // Initialize
+        setStatus(nr, 0, "OK");
+
+    } else if (command == "UI" || command == "UJ" || command == "U:" || command == "U9") {
+
+        // Reset
+        device[nr - VDR_FIRST] = Device { };
+        setStatus(nr, 73, "CBM DOS V2.6 1541");
+
+    } else if (fallBack(nr)) {
+
+        // The command is executed by the emulated drive
+
+    } else if (string("CNRSV").find(command[0]) != string::npos) {
+
+        // Copy, New, Rename, Scratch, and Validate modify the disk
+        setStatus(nr, 26, "WRITE PROTECT ON");
+
+    } else {
+
+        setStatus(nr, 31, "SYNTAX ERROR");
+    }
+}
+
+bool
+VirtualDrive::fallBack(isize nr)
+{
+    if (!canFallBack(nr)) return false;
+
+    logdebug(VDR_DEBUG, "Handing device %ld over to the emulated drive\n", nr);
+
+    // Pass all further requests to the emulated drive
+    device[nr - VDR_FIRST].fallback = true;
+
+    // Replay the bus transaction on the serial bus
+    replayPos = 0;
+    replay();
+
+    return true;
+}
+
+void
+VirtualDrive::replay()
+{
+    assert(replayPos >= 0);
+
+    if (replayPos < isize(transaction.size())) {
+
+        auto &step = transaction[replayPos++];
+
+        // Call the original routine and let it return to UNLSN
+        auto ret = u16(trapAddr[UNLSN] - 1);
+        mem.pokeStack(cpu.reg.sp--, HI_BYTE(ret));
+        mem.pokeStack(cpu.reg.sp--, LO_BYTE(ret));
+
+        cpu.reg.a = step.second;
+        cpu.reg.pc = trapAddr[step.first];
+
+    } else {
+
+        // Let the original UNLSN routine finish the transaction
+        replayPos = -1;
+        transaction.clear();
+    }
+}
+
+void
+VirtualDrive::processLoad()
+{
+    auto nr = mem.ram[FA];
+
+    // Don't intercept if the LOAD vector has been redirected
+    if (LO_HI(mem.ram[ILOAD], mem.ram[ILOAD + 1]) < 0xE000) return;
+    if (!isVirtual(nr)) return;
+
+    auto &dev = device[nr - VDR_FIRST];
+
+    // Perform the initialization steps of the original routine
+    mem.pokeZP(MEMUSS, cpu.reg.x);
+    mem.pokeZP(MEMUSS + 1, cpu.reg.y);
+    mem.pokeZP(VERCK, cpu.reg.a);
+    mem.pokeZP(STATUS, 0);
+
+    // Read the file name
+    string name;
+    auto fnadr = LO_HI(mem.ram[FNADR], mem.ram[FNADR + 1]);
+    for (isize i = 0; i < mem.ram[FNLEN]; i++) name += char(mem.spypeek(u16(fnadr + i)));
+
+    // Strip off the drive number
+    if (auto pos = name.find(':'); pos != string::npos && name[0] != '$') name = name.substr(pos + 1);
+
+    // Report 'MISSING FILE NAME'
+    if (name.empty()) { cpu.reg.a = 8; returnFromTrap(true); return; }
+
+    std::vector<u8> data;
+    if (auto code = readFile(nr, name, data); code != 0 || data.size() < 2) {
+
+        // Report 'FILE NOT FOUND'
+        setStatus(nr, code ? code : 62, code == 74 ? "DRIVE NOT READY" : "FILE NOT FOUND");
+        cpu.reg.a = 4;
+        returnFromTrap(true);
+        return;
+    }
+
+    // Determine the start address
+    u16 addr = mem.ram[SA] ? LO_HI(data[0], data[1]) : LO_HI(cpu.reg.x, cpu.reg.y);
+    bool verify = mem.ram[VERCK] != 0;
+
+    // Copy the file into memory
+    for (usize i = 2; i < data.size(); i++, addr++) {
+
+        if (verify) {
+            if (mem.spypeek(addr) != data[i]) mem.pokeZP(STATUS, mem.ram[STATUS] | 0x10);
+        } else {
+            mem.poke(addr, data[i]);
+        }
+    }
+
+    // Don't rely on the dirty pages, as the file might have reached I/O space
+    if (!verify) emulator.markAsDirty();
+
+    dev.loads++;
+    dev.bytes += isize(data.size());
+    setStatus(nr, 0, "OK");
+
+    // Return the end address
+    mem.pokeZP(EAL, cpu.reg.x = LO_BYTE(addr));
+    mem.pokeZP(EAL + 1, cpu.reg.y = HI_BYTE(addr));
+    mem.pokeZP(STATUS, mem.ram[STATUS] | 0x40);
+    returnFromTrap();
+}
+
+void
+VirtualDrive::setStatus(isize nr, isize code, const string &msg)
+{
+    auto &dev = device[nr - VDR_FIRST];
+
+    char buf[8];
+    snprintf(buf, sizeof(buf), "%02ld", long(code));
+    dev.status = string(buf) + "," + (code == 0 ? " " : "") + msg + ",00,00";
+    dev.statusPos = 0;
+}
+
+}
@@ -0,0 +1,242 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "VirtualDriveTypes.h"
+#include "SubComponent.h"
+#include "Images/D64/D64File.h"
+
+namespace vc64 {
+
+using retro::vault::image::D64File;
+
+/* The virtual drive serves devices 8 to 11 on the KERNAL level. Instead of
+ * emulating the serial bus protocol and the drive hardware cycle by cycle, it
+ * intercepts the KERNAL routines TALK, LISTEN, SECOND, TKSA, ACPTR, CIOUT,
+ * UNTLK, and UNLSN at the CPU level and answers them directly. The LOAD
+ * routine is intercepted, too, which reduces loading a file to copying it
+ * into memory.
+ *
+ * Files are served through the CBM file system. Devices 8 and 9 mirror the
+ * disk inserted into the emulated drive unless a disk has been attached to
+ * the virtual device explicitly. Devices 10 and 11 are only present if a disk
+ * has been attached. The virtual drive is read-only and only understands the
+ * commands needed for loading files and reading the directory.
+ *
+ * If a program sends a request the virtual drive cannot handle, e.g., a
+ * memory write command uploading a fast loader, the device is handed over
+ * to the emulated drive. The intercepted bus transaction is replayed by
+ * calling the original KERNAL routines one after another, and all further
+ * requests are passed through until the next reset. Because the emulated
+ * drive is never stopped, fast loaders bypassing the KERNAL entirely work
+ * out of the box.
+ */
+class VirtualDrive final : public SubComponent, public Inspectable<VirtualDriveInfo> {
+
+    Descriptions descriptions = {{
+
+        .name           = "VirtualDrive",
+        .description    = "Virtual Drive",
+        .shell          = "vdrive"
+    }};
+
+    Options options = {
+
+        Opt::VDR_ENABLE,
+        Opt::VDR_FALLBACK
+    };
+
+    // Current configuration
+    VirtualDriveConfig config = { };
+
+    // Intercepted KERNAL routines
+    enum Trap { TALK, LISTEN, SECOND, TKSA, ACPTR, CIOUT, UNTLK, UNLSN, LOAD, TRAP_COUNT };
+
+    // Entry points of the intercepted routines (0 = not intercepted)
+    u16 trapAddr[TRAP_COUNT] = { };
+
+    // A single logical channel
+    struct Channel {
+
+        // File contents
+        std::vector<u8> data;
+
+        // Read position
+        isize pos = 0;
+
+        // Indicates if the channel has been opened
+        bool open = false;
+    };
+
+    // The state of a single virtual device
+    struct Device {
+
+        // Channels 0 to 14 (channel 15 is the command channel)
+        Channel channel[15];
+
+        // Contents of the error channel
+        string status = "00, OK,00,00";
+
+        // Read position in the error channel
+        isize statusPos = 0;
+
+        // Indicates if the device has been handed over to the emulated drive
+        bool fallback = false;
+
+        // Statistics
+        isize files = 0;
+        isize loads = 0;
+        i64 bytes = 0;
+    };
+
+    // Devices 8 to 11
+    Device device[VDR_COUNT];
+
+    // Disks attached to devices 8 to 11 (shared with the run-ahead instance)
+    std::shared_ptr<D64File> media[VDR_COUNT];
+
+    // The device that has been addressed by LISTEN or TALK (0 = none)
+    isize listener = 0;
+    isize talker = 0;
+
+    // The channel that has been selected by TKSA
+    isize talkChannel = 0;
+
+    // The bus transaction that has been recorded since LISTEN
+    std::vector<std::pair<Trap, u8>> transaction;
+
+    // Index of the next transaction step to replay (-1 = not replaying)
+    isize replayPos = -1;
+
+
+    //
+    // Methods
+    //
+
+public:
+
+    using SubComponent::SubComponent;
+
+    VirtualDrive& operator= (const VirtualDrive& other);
+
+
+    //
+    // Methods from Serializable
+    //
+
+public:
+
+    template <class T> void serialize(T& worker) { } SERIALIZERS(serialize);
+
+
+    //
+    // Methods from CoreComponent
+    //
+
+public:
+
+    const Descriptions &getDescriptions() const override { return descriptions; }
+
+private:
+
+    void _dump(Category category, std::ostream &os) const override;
+    void _didReset(bool hard) override;
+    void _didLoad() override;
+
+
+    //
+    // Methods from Inspectable
+    //
+
+public:
+
+    void cacheInfo(VirtualDriveInfo &result) const override;
+
+
+    //
+    // Methods from Configurable
+    //
+
+public:
+
+    const VirtualDriveConfig &getConfig() const { return config; }
+    const Options &getOptions() const override { return options; }
+    i64 getOption(Opt opt) const override;
+    void checkOption(Opt opt, i64 value) override;
+    void setOption(Opt opt, i64 value) override;
+
+
+    //
+    // Managing media
+    //
+
+public:
+
+    // Attaches a disk image, a file collection, or a directory to a device
+    void attach(isize nr, const fs::path &path);
+
+    // Detaches the disk from a device
+    void detach(isize nr);
+
+private:
+
+    // Checks if a device is served by the virtual drive
+    bool isVirtual(isize nr) const;
+
+    // Checks if a device can be handed over to the emulated drive
+    bool canFallBack(isize nr) const;
+
+    // Reads a file or the directory from the medium of a device
+    isize readFile(isize nr, const string &name, std::vector<u8> &data);
+
+
+    //
+    // Intercepting KERNAL routines
+    //
+
+public:
+
+    // Reads the entry points of the intercepted routines from the KERNAL
+    void updateTraps();
+
+    // Called by the CPU at each instruction boundary
+    void processTrap(u16 addr);
+
+private:
+
+    // Returns from the intercepted routine
+    void returnFromTrap(bool carry = false);
+
+    // Handles the intercepted routines
+    void processTalk(u8 nr);
+    void processListen(u8 nr);
+    void processAcptr();
+    void processUnlisten();
+    void processLoad();
+
+    // Executes the recorded transaction
+    void processOpen(isize nr, isize sa, const string &name);
+    void processClose(isize nr, isize sa);
+    void processCommand(isize nr, const string &cmd);
+
+    // Hands a device over to the emulated drive and replays the transaction
+    bool fallBack(isize nr);
+
+    // Replays the next step of the recorded transaction
+    void replay();
+
+    // Sets the contents of the error channel
+    void setStatus(isize nr, isize code, const string &msg);
+};
+
+}
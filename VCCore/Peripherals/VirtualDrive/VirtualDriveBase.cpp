@@ -0,0 +1,168 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+
+#include "vcconfig.h"
+#include "VirtualDrive.h"
+#include "C64.h"
+
+namespace vc64 {
+
+VirtualDrive&
+VirtualDrive::operator= (const VirtualDrive& other)
+{
+    CLONE_ARRAY(trapAddr)
+    CLONE_ARRAY(device)
+    CLONE_ARRAY(media)
+    CLONE(listener)
+    CLONE(talker)
+    CLONE(talkChannel)
+    CLONE(transaction)
+    CLONE(replayPos)
+
+    CLONE(config)
+
+    return *this;
+}
+
+void
+VirtualDrive::_dump(Category category, std::ostream &os) const
+{
+    using namespace utl;
+
+    if (category == Category::Config) {
+
+        dumpConfig(os);
+    }
+
+    if (category == Category::State) {
+
+        auto info = getInfo();
+
+        for (isize i = 0; i < VDR_COUNT; i++) {
+
+            auto &dev = info.device[i];
+
+            os << tab("Device " + std::to_string(VDR_FIRST + i));
+            if (dev.fallback) {
+                os << "Emulated drive";
+            } else if (dev.attached) {
+                os << "Attached disk";
+            } else if (dev.mirrored) {
+                os << "Disk of the emulated drive";
+            } else {
+                os << "Not present";
+            }
+            os << std::endl;
+
+            if (dev.attached || dev.mirrored) {
+
+                os << tab("Files");
+                os << dec(dev.files) << " opened, " << dec(dev.loads) << " loaded" << std::endl;
+                os << tab("Transferred");
+                os << dec(dev.bytes) << " bytes" << std::endl;
+                os << tab("Status");
+                os << device[i].status << std::endl;
+            }
+        }
+    }
+}
+
+void
+VirtualDrive::_didReset(bool hard)
+{
+    for (isize i = 0; i < VDR_COUNT; i++) device[i] = Device { };
+
+    listener = talker = 0;
+    transaction.clear();
+    replayPos = -1;
+
+    updateTraps();
+}
+
+void
+VirtualDrive::_didLoad()
+{
+    updateTraps();
+}
+
+void
+VirtualDrive::cacheInfo(VirtualDriveInfo &result) const
+{
+    {   SYNCHRONIZED
+
+        for (isize i = 0; i < VDR_COUNT; i++) {
+
+            auto &dev = result.device[i];
+
+            dev.attached = media[i] != nullptr;
+            dev.mirrored = !dev.attached && i < 2 && drive[i]->connectedAndOn();
+            dev.fallback = device[i].fallback;
+            dev.files = device[i].files;
+            dev.loads = device[i].loads;
+            dev.bytes = device[i].bytes;
+        }
+    }
+}
+
+i64
+VirtualDrive::getOption(Opt option) const
+{
+    switch (option) {
+
+        case Opt::VDR_ENABLE:        return (i64)config.enable;
+        case Opt::VDR_FALLBACK:      return (i64)config.fallback;
+
+        default:
+            fatalError;
+    }
+}
+
+void
+VirtualDrive::checkOption(Opt opt, i64 value)
+{
+    switch (opt) {
+
+        case Opt::VDR_ENABLE:
+        case Opt::VDR_FALLBACK:
+
+            return;
+
+        default:
+            throw CoreError(CoreError::OPT_UNSUPPORTED);
+    }
+}
+
+void
+VirtualDrive::setOption(Opt opt, i64 value)
+{
+    checkOption(opt, value);
+
+    switch (opt) {
+
+        case Opt::VDR_ENABLE:
+
+            config.enable = bool(value);
+            for (isize i = 0; i < VDR_COUNT; i++) device[i].fallback = false;
+            updateTraps();
+            return;
+
+        case Opt::VDR_FALLBACK:
+
+            config.fallback = bool(value);
+            return;
+
+        default:
+            fatalError;
+    }
+}
+
+}
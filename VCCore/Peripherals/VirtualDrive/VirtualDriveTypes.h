@@ -0,0 +1,74 @@
+// -----------------------------------------------------------------------------
+// This file is part of VirtualC64
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// This FILE is dual-licensed. You are free to choose between:
+//
+//     - The GNU General Public License v3 (or any later version)
+//     - The Mozilla Public License v2
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR MPL-2.0
+// -----------------------------------------------------------------------------
+/// @file
+
+#pragma once
+
+#include "BasicTypes.h"
+
+namespace vc64 {
+
+//
+// Constants
+//
+
+//! Device number of the first virtual drive
+static constexpr isize VDR_FIRST = 8;
+
+//! Number of virtual drives (device numbers 8 to 11)
+static constexpr isize VDR_COUNT = 4;
+
+
+//
+// Structures
+//
+
+typedef struct
+{
+    //! Indicates if the KERNAL serial bus routines are intercepted
+    bool enable;
+
+    //! Indicates if unsupported requests are handed over to the real drive
+    bool fallback;
+}
+VirtualDriveConfig;
+
+typedef struct
+{
+    //! Indicates if a disk has been attached to the virtual device
+    bool attached;
+
+    //! Indicates if the device is served from the emulated drive's disk
+    bool mirrored;
+
+    //! Indicates if the device has been handed over to the emulated drive
+    bool fallback;
+
+    //! Number of opened files
+    isize files;
+
+    //! Number of trapped LOAD calls
+    isize loads;
+
+    //! Number of transferred bytes
+    i64 bytes;
+}
+VirtualDeviceInfo;
+
+typedef struct
+{
+    //! Information about devices 8 to 11
+    VirtualDeviceInfo device[VDR_COUNT];
+}
+VirtualDriveInfo;
+
+}
@@ -41,7 +41,8 @@ AudioPort::generateSamples()
     // Send the MUTE message if needed
     if (muted != wasMuted) { msgQueue.put(Msg::MUTE, wasMuted = muted); }
 
-    stream.mutex.lock();
+    // Check if the audio unit has run out of samples
+    if (stream.underflowed()) handleBufferUnderflow();
 
     // Check how many samples can be generated
     auto s0 = sid0.stream.count();
@@ -56,6 +57,7 @@ AudioPort::generateSamples()
 
     // Check for a buffer overflow
     if (stream.free() < numSamples) handleBufferOverflow();
+    stats.producedSamples += numSamples;
 
     // Generate the samples
     bool fading = volL.isFading() || volR.isFading();
@@ -65,8 +67,6 @@ AudioPort::generateSamples()
     } else {
         fading ? mixSingleSID<true>(numSamples) : mixSingleSID<false>(numSamples);
     }
-
-    stream.mutex.unlock();
 }
 
 void
@@ -232,8 +232,7 @@ AudioPort::mixMultiSID(isize numSamples)
 void
 AudioPort::handleBufferUnderflow()
 {
-    // Wipe out the buffer and reset the write pointer
-    stream.clear(SamplePair{0,0});
+    // Refill the buffer with silence
     stream.alignWritePtr();
 
     // Determine the elapsed seconds since the last pointer adjustment
@@ -255,8 +254,8 @@ AudioPort::handleBufferUnderflow()
 void
 AudioPort::handleBufferOverflow()
 {
-    // Reset the write pointer
-    stream.alignWritePtr();
+    // Let the audio unit skip the oldest samples
+    stream.trim(stream.cap() / 2);
 
     // Determine the number of elapsed seconds since the last adjustment
     auto elapsedTime = utl::Time::now() - lastAlignment;
@@ -286,13 +285,7 @@ isize
 AudioPort::copyMono(float *buffer, isize n)
 {
     // Copy sound samples
-    auto cnt = stream.copyMono(buffer, n);
-    stats.consumedSamples += cnt;
-
-    // Check for a buffer underflow
-    if (cnt < n) handleBufferUnderflow();
-
-    return cnt;
+    return stream.copyMono(buffer, n);
 }
 
 isize
@@ -302,26 +295,14 @@ AudioPort::copyStereo(float *left, float *right, isize n)
     detector.feed(n);
 
     // Copy sound samples
-    auto cnt = stream.copyStereo(left, right, n);
-    stats.consumedSamples += cnt;
-
-    // Check for a buffer underflow
-    if (cnt < n) handleBufferUnderflow();
-
-    return cnt;
+    return stream.copyStereo(left, right, n);
 }
 
 isize
 AudioPort::copyInterleaved(float *buffer, isize n)
 {
     // Copy sound samples
-    auto cnt = stream.copyInterleaved(buffer, n);
-    stats.consumedSamples += cnt;
-
-    // Check for a buffer underflow
-    if (cnt < n) handleBufferUnderflow();
-
-    return cnt;
+    return stream.copyInterleaved(buffer, n);
 }
 
 }
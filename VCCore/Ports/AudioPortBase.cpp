@@ -72,9 +72,16 @@ AudioPort::cacheInfo(AudioPortInfo &result) const
 void
 AudioPort::cacheStats(AudioPortStats &result) const
 {
+    static_assert(AudioStream::latencyBuckets == isize(sizeof(AudioPortStats::latency) / sizeof(i64)));
+
     {   SYNCHRONIZED
         
         result.fillLevel = stream.fillLevel();
+        result.consumedSamples = stream.getConsumed();
+
+        for (isize i = 0; i < AudioStream::latencyBuckets; i++) {
+            result.latency[i] = stream.getLatency(i);
+        }
     }
 }
 
@@ -275,6 +282,8 @@ AudioPort::setSampleRate(double hz)
         sampleRate = detector.sampleRate();
         logdebug(AUD_DEBUG, "setSampleRate(%.2f) (predicted)\n", sampleRate);
     }
+
+    stream.setSampleRate(sampleRate);
 }
 
 }
@@ -67,6 +67,9 @@ typedef struct
 
     // Total number of sampels grabbed by the audio backend
     i64 consumedSamples;
+
+    // Latency histogram (buffered audio in 8 ms steps, sampled per request)
+    i64 latency[16];
 }
 AudioPortStats;
 
@@ -73,6 +73,9 @@ public:
     ExpansionPort(C64 &ref) : SubComponent(ref) { };
     ExpansionPort& operator= (const ExpansionPort& other);
 
+    // Copies only those parts of another port that have been modified
+    void syncWith(ExpansionPort &other);
+
 
     //
     // Methods from Serializable
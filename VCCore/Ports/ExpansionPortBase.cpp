@@ -38,6 +38,18 @@ ExpansionPort::operator= (const ExpansionPort& other)
     return *this;
 }
 
+void
+ExpansionPort::syncWith(ExpansionPort &other)
+{
+    // Synchronize the cartridge RAM incrementally if the cartridges match
+    if (cartridge && other.cartridge && getCartridgeType() == other.getCartridgeType()) {
+        cartridge->syncRamWith(*other.cartridge);
+    }
+
+    // Clone the rest (the RAM is skipped if it is in sync already)
+    *this = other;
+}
+
 void
 ExpansionPort::operator << (SerResetter &worker)
 {
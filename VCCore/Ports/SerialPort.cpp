@@ -92,8 +92,13 @@ SerialPort::updateIecLines()
     bool signalsChanged = _updateIecLines();
 
     if (signalsChanged) {
-        
-        cia2.updatePA();
+
+        // Let CIA2 see the new values (deferred on the drive thread)
+        if (DriveThread::isWorker()) {
+            ciaIsStale = true;
+        } else {
+            cia2.updatePA();
+        }
         
         // Wake up drives
         drive8.wakeUp();
@@ -114,14 +119,18 @@ SerialPort::updateIecLines()
 void 
 SerialPort::setNeedsUpdate()
 {
-    c64.scheduleImm<SLOT_SER>(SER_UPDATE);
+    if (DriveThread::isWorker()) {
+        pendingUpdate = true;
+    } else {
+        c64.scheduleImm<SLOT_SER>(SER_UPDATE);
+    }
 }
 
 void
 SerialPort::update()
 {
     // Get bus signals from C64 side
-    u8 ciaBits = cia2.getPA();
+    u8 ciaBits = ciaIsStale ? cia2.computePA() : cia2.getPA();
     ciaAtn = !!(ciaBits & 0x08);
     ciaClock = !!(ciaBits & 0x10);
     ciaData = !!(ciaBits & 0x20);
@@ -140,7 +149,24 @@ SerialPort::update()
 
     updateIecLines();
 
-    c64.cancel<SLOT_SER>();
+    pendingUpdate = false;
+    if (!DriveThread::isWorker()) c64.cancel<SLOT_SER>();
+}
+
+void
+SerialPort::finishPendingUpdate(bool schedule)
+{
+    if (ciaIsStale) {
+
+        cia2.refreshPA();
+        ciaIsStale = false;
+    }
+
+    if (pendingUpdate) {
+
+        pendingUpdate = false;
+        schedule ? setNeedsUpdate() : update();
+    }
 }
 
 void
@@ -19,6 +19,8 @@ namespace vc64 {
 
 class SerialPort final : public SubComponent, public Inspectable<Void, SerialPortStats> {
 
+    friend class DriveThread;
+
     Descriptions descriptions = {{
 
         .type           = Class::SerialPort,
@@ -58,6 +60,16 @@ private:
     // Indicates whether data is being transferred from or to a drive
     bool transferring = false;
 
+    /* If the drives are emulated by the drive thread, bus updates triggered
+     * by the drives are not scheduled as events. They are recorded here and
+     * processed in the next cycle. Both variables are cleared at the end of
+     * each frame.
+     */
+    bool pendingUpdate = false;
+
+    // Indicates if the data port of CIA2 is out of date
+    bool ciaIsStale = false;
+
     
     //
     // Methods
@@ -165,6 +177,12 @@ public:
     
     // Updates variable transferring
     void updateTransferStatus();
+
+    /* Completes the work left over by the drive thread. A bus update that has
+     * been requested by the drives in the most recent cycle is either
+     * processed immediately or scheduled as a regular event.
+     */
+    void finishPendingUpdate(bool schedule);
     
 private:
     
@@ -57,6 +57,12 @@ VideoPort::_dump(Category category, std::ostream &os) const
     }
 }
 
+void
+VideoPort::cacheInfo(VideoPortInfo &result) const
+{
+    result.latestGrabbedFrame = latestGrabbedFrame;
+}
+
 i64
 VideoPort::getOption(Opt option) const
 {
@@ -106,7 +112,7 @@ VideoPort::getTexture(isize offset) const
     if (isPoweredOn()) {
 
         auto &result = vic.getStableBuffer(offset);
-        info.latestGrabbedFrame = result.nr;
+        latestGrabbedFrame = result.nr;
         return result;
     }
     if (config.whiteNoise) {
@@ -133,11 +139,49 @@ VideoPort::getDmaTexture(isize offset) const
     }
 }
 
+const class Texture &
+VideoPort::acquireTexture(isize offset, isize consumer) const
+{
+    if (isPoweredOn()) {
+
+        auto &result = vic.acquireStableBuffer(consumer, offset);
+        if (consumer == TEX_CONSUMER_GUI) latestGrabbedFrame = result.nr;
+        return result;
+    }
+
+    releaseTexture(consumer);
+    return getTexture(offset);
+}
+
+const class Texture &
+VideoPort::acquireDmaTexture(isize offset, isize consumer) const
+{
+    if (isPoweredOn()) {
+
+        return vic.acquireStableDmaBuffer(consumer, offset);
+    }
+
+    releaseDmaTexture(consumer);
+    return blank;
+}
+
+void
+VideoPort::releaseTexture(isize consumer) const
+{
+    vic.releaseStableBuffer(consumer);
+}
+
+void
+VideoPort::releaseDmaTexture(isize consumer) const
+{
+    vic.releaseStableDmaBuffer(consumer);
+}
+
 void
 VideoPort::buffersWillSwap()
 {
     // Check if the texture has been grabbed
-    auto grabbed = info.latestGrabbedFrame;
+    i64 grabbed = latestGrabbedFrame;
     auto current = vic.getStableBuffer().nr;
 
     if (grabbed < current) {
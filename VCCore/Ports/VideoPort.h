@@ -15,6 +15,7 @@
 #include "VideoPortTypes.h"
 #include "SubComponent.h"
 #include "Texture.h"
+#include <atomic>
 
 namespace vc64 {
 
@@ -43,6 +44,9 @@ class VideoPort final : public SubComponent, public Inspectable<VideoPortInfo, V
     //  White noise data
     utl::Buffer <Texel> noise;
 
+    // Frame number of the most recently acquired texture
+    mutable std::atomic<i64> latestGrabbedFrame = 0;
+
     //
     // Methods
     //
@@ -89,6 +93,15 @@ private:
     void _dump(Category category, std::ostream &os) const override;
 
 
+    //
+    // Methods from Inspectable
+    //
+
+public:
+
+    void cacheInfo(VideoPortInfo &result) const override;
+
+
     //
     // Methods from Configurable
     //
@@ -114,6 +127,16 @@ public:
     // Returns a pointer to the bus debugger texture
     const class Texture &getDmaTexture(isize offset = 0) const;
 
+    /* Returns a texture and protects it from being overwritten. These
+     * functions are called by consumers outside of the emulator thread. They
+     * never block. The texture stays intact until the consumer releases it or
+     * acquires another texture.
+     */
+    const class Texture &acquireTexture(isize offset = 0, isize consumer = TEX_CONSUMER_GUI) const;
+    const class Texture &acquireDmaTexture(isize offset = 0, isize consumer = TEX_CONSUMER_GUI) const;
+    void releaseTexture(isize consumer = TEX_CONSUMER_GUI) const;
+    void releaseDmaTexture(isize consumer = TEX_CONSUMER_GUI) const;
+
     // Informs the video port about a buffer swap
     void buffersWillSwap();
 
@@ -16,6 +16,20 @@
 
 namespace vc64 {
 
+//
+// Constants
+//
+
+//! Texture consumer of the graphical user interface
+static constexpr isize TEX_CONSUMER_GUI = 0;
+
+//! Texture consumer of the RPC server
+static constexpr isize TEX_CONSUMER_RPC = 1;
+
+//! Number of consumers that can hold textures at the same time
+static constexpr isize TEX_CONSUMERS = 2;
+
+
 //
 // Structures
 //
@@ -539,8 +539,23 @@ C64API::saveWorkspace(const fs::path &path) const
 std::unique_ptr<Snapshot>
 C64API::takeSnapshot(Compressor compressor, isize delay, bool repeat)
 {
-    VC64_PUBLIC_SUSPEND
-    return c64->takeSnapshotNew(compressor, delay, repeat);
+    VC64_PUBLIC
+
+    if (delay != 0) {
+
+        VC64_PUBLIC_SUSPEND
+        return c64->takeSnapshotNew(compressor, delay, repeat);
+    }
+
+    // Only serialize while the emulator is suspended
+    std::unique_ptr<Snapshot> result;
+    {   VC64_PUBLIC_SUSPEND
+        result = c64->takeSnapshotNew(Compressor::NONE);
+    }
+
+    // Compress the snapshot while the emulator keeps running
+    result->compress(compressor);
+    return result;
 }
 
 
@@ -584,6 +599,13 @@ C64API::saveSnapshot(const fs::path &path, Compressor compressor) const
 
 }
 
+void
+C64API::rewind(isize frames)
+{
+    VC64_PUBLIC
+    emu->put(Cmd::REWIND, frames);
+}
+
 void
 C64API::loadRom(const fs::path &path)
 {
@@ -946,6 +968,24 @@ VideoPortAPI::getTexture(isize *nr, isize *width, isize *height) const
     return (u32 *)texture.pixels.ptr;
 }
 
+std::span<const u32>
+VideoPortAPI::acquireTexture(isize *nr) const
+{
+    VC64_PUBLIC
+    auto &texture = emu->getTexture();
+
+    if (nr) *nr = isize(texture.nr);
+
+    return std::span<const u32>((const u32 *)texture.pixels.ptr, Texture::texels);
+}
+
+void
+VideoPortAPI::releaseTexture() const
+{
+    VC64_PUBLIC
+    emu->releaseTextures();
+}
+
 const u32 *
 VideoPortAPI::getDmaTexture() const
 {
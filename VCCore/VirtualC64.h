@@ -17,6 +17,7 @@
 #include "CoreError.h"
 #include "Snapshot.h"
 #include "FileSystems/CBM/FSTypes.h"
+#include <span>
 
 using retro::vault::cbm::FSFormat;
 
@@ -291,15 +292,14 @@ struct VideoPortAPI : public API {
 
     /** @brief  Locks the emulator texture
      *
-     * This function aquires a mutex that prevents the emulator to modify the
-     * stable texture. Call this function prior to getTexture().
+     * @note This function is no longer required. Textures returned by
+     * getTexture() are protected from being overwritten without locking.
      */
     void lockTexture();
 
     /** @brief  Unlocks the emulator texture
      *
-     * This function releases the mutex acquired in lockTexture(). Call this
-     * function when the pointer returned by getTexture() is no longer needed.
+     * @note This function is no longer required.
      */
     void unlockTexture();
 
@@ -308,6 +308,10 @@ struct VideoPortAPI : public API {
      * The texture dimensions are given by constants vc64::Texture::width
      * and vc64::Texture::height texels. Each texel is represented by a
      * 32 bit color value.
+     *
+     * This function never blocks the emulator thread. The returned texture
+     * stays intact until getTexture() is called again or the texture is
+     * released by calling releaseTexture().
      */
     const u32 *getTexture() const;
     const u32 *getTexture(isize *nr, isize *width, isize *height) const;
@@ -315,6 +319,16 @@ struct VideoPortAPI : public API {
     const u32 *getDmaTexture() const;
     const u32 *getDmaTexture(isize *nr, isize *width, isize *height) const;
 
+    /** @brief  Returns the most recent stable texture as a read-only span
+     *
+     * @param   nr  If not null, receives the frame number of the texture.
+     */
+    std::span<const u32> acquireTexture(isize *nr = nullptr) const;
+
+    /** @brief  Releases all textures handed out by the video port
+     */
+    void releaseTexture() const;
+
     /** @brief Analyzes the current texture and determines coordinates for border cropping
      */
     void findInnerArea(isize &x1, isize &x2, isize &y1, isize &y2) const;
@@ -1122,6 +1136,16 @@ struct C64API : public API {
      */
     void saveSnapshot(const std::filesystem::path &path, Compressor compressor) const;
 
+    /** @brief  Reverts to a previously recorded state
+     *
+     *  @param  frames      Number of frames to travel back in time
+     *
+     *  @note   Frames are only recorded if a memory budget has been assigned
+     *          to the rewind buffer via option REW_BUDGET. The request is
+     *          processed asynchronously at the next frame boundary.
+     */
+    void rewind(isize frames);
+
 
     /// @}
     /// @name Handling ROMs
@@ -80,6 +80,7 @@ DEBUG_CHANNEL(PIA_DEBUG,        "PIA chip");
 DEBUG_CHANNEL(SER_DEBUG,        "Serial port (IEC bus)");
 DEBUG_CHANNEL(DSK_DEBUG,        "Disk");
 DEBUG_CHANNEL(DSKCHG_DEBUG,     "Disk change procedure");
+DEBUG_CHANNEL(DSK_SAFE_MODE,    "Disk read optimizations");
 DEBUG_CHANNEL(GCR_DEBUG,        "GCR encoding");
 DEBUG_CHANNEL(FS_DEBUG,         "File system");
 DEBUG_CHANNEL(PAR_DEBUG,        "Parallel port");
@@ -92,6 +93,7 @@ DEBUG_CHANNEL(FILE_DEBUG,       "Media files");
 // Peripherals
 DEBUG_CHANNEL(JOY_DEBUG,        "Joystick");
 DEBUG_CHANNEL( DRV_DEBUG,       "Floppy drive");
+DEBUG_CHANNEL( VDR_DEBUG,       "Virtual drive");
 DEBUG_CHANNEL(TAP_DEBUG,        "Datasette");
 DEBUG_CHANNEL(KBD_DEBUG,        "Keyboard");
 DEBUG_CHANNEL(PRT_DEBUG,        "Ports");
@@ -74,6 +74,7 @@ constexpr long PIA_DEBUG       = 0;
 constexpr long SER_DEBUG       = 0;
 constexpr long DSK_DEBUG       = 0;
 constexpr long DSKCHG_DEBUG    = 0;
+constexpr long DSK_SAFE_MODE   = 0;
 constexpr long GCR_DEBUG       = 0;
 constexpr long FS_DEBUG        = 0;
 constexpr long PAR_DEBUG       = 0;
@@ -86,6 +87,7 @@ constexpr long FILE_DEBUG      = 0;
 // Peripherals
 constexpr long JOY_DEBUG       = 0;
 constexpr long DRV_DEBUG       = 0;
+constexpr long VDR_DEBUG       = 0;
 constexpr long TAP_DEBUG       = 0;
 constexpr long KBD_DEBUG       = 0;
 constexpr long PRT_DEBUG       = 0;
@@ -206,6 +208,7 @@ extern long PIA_DEBUG;
 extern long SER_DEBUG;
 extern long DSK_DEBUG;
 extern long DSKCHG_DEBUG;
+extern long DSK_SAFE_MODE;
 extern long GCR_DEBUG;
 extern long FS_DEBUG;
 extern long PAR_DEBUG;
@@ -218,6 +221,7 @@ extern long FILE_DEBUG;
 // Peripherals
 extern long JOY_DEBUG;
 extern long DRV_DEBUG;
+extern long VDR_DEBUG;
 extern long TAP_DEBUG;
 extern long KBD_DEBUG;
 extern long PRT_DEBUG;